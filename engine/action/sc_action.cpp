@@ -266,20 +266,6 @@ struct action_execute_event_t : public player_event_t
   }
 };
 
-struct aoe_target_list_callback_t
-{
-  action_t* action;
-
-  aoe_target_list_callback_t( action_t* a ) :
-    action( a ) {}
-
-  void operator()(player_t*)
-  {
-    // Invalidate target cache
-    action -> target_cache.is_valid = false;
-  }
-};
-
 struct power_entry_without_aura
 {
   bool operator()( const spellpower_data_t* p )
@@ -1282,16 +1268,8 @@ void action_t::consume_resource()
 
 int action_t::num_targets() const
 {
-  int count = 0;
-  for ( size_t i = 0, actors = sim -> actor_list.size(); i < actors; i++ )
-  {
-    player_t* t = sim -> actor_list[ i ];
-
-    if ( ! t -> is_sleeping() && t -> is_enemy() )
-      count++;
-  }
-
-  return count;
+  // Enemies are in the non-sleeping target list from arise to demise
+  return as<int>( sim -> target_non_sleeping_list.size() );
 }
 
 // action_t::available_targets ==============================================
@@ -1335,7 +1313,7 @@ size_t action_t::available_targets( std::vector< player_t* >& tl ) const
 std::vector< player_t* >& action_t::target_list() const
 {
   // Check if target cache is still valid. If not, recalculate it
-  if ( !target_cache.is_valid )
+  if ( !target_cache.check_valid() )
   {
     available_targets( target_cache.list ); // This grabs the full list of targets, which will also pickup various awfulness that some classes have.. such as prismatic crystal.
     check_distance_targeting( target_cache.list );
@@ -1531,13 +1509,13 @@ void action_t::execute()
       // "On spell cast", only performed for foreground actions
       if ( ( pt2 = execute_state -> cast_proc_type2() ) != PROC2_INVALID )
       {
-        action_callback_t::trigger( player -> callbacks.procs[ pt ][ pt2 ], this, execute_state );
+        player -> callbacks.trigger( pt, pt2, this, execute_state );
       }
 
       // "On an execute result"
       if ( ( pt2 = execute_state -> execute_proc_type2() ) != PROC2_INVALID )
       {
-        action_callback_t::trigger( player -> callbacks.procs[ pt ][ pt2 ], this, execute_state );
+        player -> callbacks.trigger( pt, pt2, this, execute_state );
       }
     }
   }
@@ -2251,7 +2229,7 @@ bool action_t::init_finished()
 
 void action_t::init_target_cache()
 {
-  sim -> target_non_sleeping_list.register_callback( aoe_target_list_callback_t( this ) );
+  target_cache.source = &( sim -> target_non_sleeping_list );
 }
 
 // action_t::reset ==========================================================
@@ -43,96 +43,124 @@ bool action_t::execute_targeting( action_t* action ) const
   return true;
 }
 
-std::vector<player_t*> action_t::targets_in_range_list(
+std::vector<player_t*>& action_t::targets_in_range_list(
     std::vector<player_t*>& tl ) const
 {
-  size_t i = tl.size();
-  while ( i > 0 )
+  if ( range > 0.0 && sim->distance_targeting_enabled )
   {
-    i--;
-    player_t* target_ = tl[ i ];
-    if ( range > 0.0 && player->get_player_distance( *target_ ) > range )
+    sim->actor_grid.mark( player->x_position, player->y_position, range );
+  }
+
+  auto out_of_range = [this]( player_t* target_ ) {
+    if ( range > 0.0 && sim->distance_targeting_enabled &&
+         !sim->actor_grid.marked( target_ ) )
     {
-      tl.erase( tl.begin() + i );
+      return true;
     }
-    else if ( !ground_aoe && target_->debuffs.invulnerable->check() )
+    else if ( range > 0.0 && player->get_player_distance( *target_ ) > range )
     {
-      // Cannot target invulnerable mobs, unless it's a ground aoe. It just
-      // won't do damage.
-      tl.erase( tl.begin() + i );
+      return true;
     }
-  }
+    // Cannot target invulnerable mobs, unless it's a ground aoe. It just
+    // won't do damage.
+    return !ground_aoe && target_->debuffs.invulnerable->check();
+  };
+
+  tl.erase( std::remove_if( tl.begin(), tl.end(), out_of_range ), tl.end() );
   return tl;
 }
 
-std::vector<player_t*> action_t::check_distance_targeting(
+std::vector<player_t*>& action_t::check_distance_targeting(
     std::vector<player_t*>& tl ) const
 {
   if ( sim -> distance_targeting_enabled )
   {
-    size_t i = tl.size();
-    while ( i > 0 )
-    {
-      i--;
-      player_t* t = tl[i];
-      if ( t != target )
-      {
+    // All targets are checked against the same point, with the same distance
+    bool check_distance = true, add_reach = true;
+    double x = player->x_position, y = player->y_position, distance = 0;
+    if ( radius > 0 && range > 0 )
+    {  // Abilities with range/radius radiate from the target.
+      distance = radius;
+      if ( ground_aoe && parent_dot && parent_dot->is_ticking() )
+      {  // We need to check the parents dot for location.
         if ( sim->log )
-        {
-          sim->out_debug.printf(
-            "%s action %s - Range %.3f, Radius %.3f, player location "
-            "x=%.3f,y=%.3f, original target: %s - location: x=%.3f,y=%.3f, "
-            "impact target: %s - location: x=%.3f,y=%.3f",
-            player->name(), name(), range, radius, player->x_position,
-            player->y_position, target->name(), target->x_position,
-            target->y_position, t->name(), t->x_position, t->y_position );
-        }
-        if ( ( ground_aoe && t->debuffs.flying->check() ) )
-        {
-          tl.erase( tl.begin() + i );
-        }
-        else if ( radius > 0 && range > 0 )
-        {  // Abilities with range/radius radiate from the target.
-          if ( ground_aoe && parent_dot && parent_dot->is_ticking() )
-          {  // We need to check the parents dot for location.
-            if ( sim->log )
-              sim->out_debug.printf( "parent_dot location: x=%.3f,y%.3f",
-                                     parent_dot->state->original_x,
-                                     parent_dot->state->original_y );
-            if ( t->get_ground_aoe_distance( *parent_dot->state ) >
-                 radius + t->combat_reach )
-            {
-              tl.erase( tl.begin() + i );
-            }
-          }
-          else if ( ground_aoe && execute_state )
-          {
-            if ( t->get_ground_aoe_distance( *execute_state ) >
-                 radius + t->combat_reach )
-            {
-              tl.erase( tl.begin() + i );  // We should just check the child.
-            }
-          }
-          else if ( t->get_player_distance( *target ) > radius )
-          {
-            tl.erase( tl.begin() + i );
-          }
-        }  // If they do not have a range, they are likely based on the distance
-           // from the player.
-        else if ( radius > 0 &&
-                  t->get_player_distance( *player ) > radius + t->combat_reach )
-        {
-          tl.erase( tl.begin() + i );
-        }
-        else if ( range > 0 &&
-                  t->get_player_distance( *player ) > range + t->combat_reach )
-        {
-          // If they only have a range, then they are a single target ability, or
-          // are also based on the distance from the player.
-          tl.erase( tl.begin() + i );
-        }
+          sim->out_debug.printf( "parent_dot location: x=%.3f,y%.3f",
+                                 parent_dot->state->original_x,
+                                 parent_dot->state->original_y );
+        x = parent_dot->state->original_x;
+        y = parent_dot->state->original_y;
       }
+      else if ( ground_aoe && execute_state )
+      {  // We should just check the child.
+        x = execute_state->original_x;
+        y = execute_state->original_y;
+      }
+      else
+      {
+        x        = target->x_position;
+        y        = target->y_position;
+        add_reach = false;
+      }
+    }  // If they do not have a range, they are likely based on the distance
+       // from the player.
+    else if ( radius > 0 )
+    {
+      distance = radius;
+    }
+    else if ( range > 0 )
+    {
+      // If they only have a range, then they are a single target ability, or
+      // are also based on the distance from the player.
+      distance = range;
     }
+    else
+    {
+      check_distance = false;
+    }
+
+    if ( check_distance )
+    {
+      sim->actor_grid.mark( x, y, distance );
+    }
+
+    auto out_of_range = [&]( player_t* t ) {
+      if ( t == target )
+      {
+        return false;
+      }
+
+      if ( sim->log )
+      {
+        sim->out_debug.printf(
+          "%s action %s - Range %.3f, Radius %.3f, player location "
+          "x=%.3f,y=%.3f, original target: %s - location: x=%.3f,y=%.3f, "
+          "impact target: %s - location: x=%.3f,y=%.3f",
+          player->name(), name(), range, radius, player->x_position,
+          player->y_position, target->name(), target->x_position,
+          target->y_position, t->name(), t->x_position, t->y_position );
+      }
+
+      if ( ground_aoe && t->debuffs.flying->check() )
+      {
+        return true;
+      }
+
+      if ( !check_distance )
+      {
+        return false;
+      }
+
+      if ( !sim->actor_grid.marked( t ) )
+      {
+        return true;
+      }
+
+      return t->get_position_distance( x, y ) >
+             distance + ( add_reach ? t->combat_reach : 0 );
+    };
+
+    tl.erase( std::remove_if( tl.begin(), tl.end(), out_of_range ), tl.end() );
+
     if ( sim->log )
     {
       sim->out_debug.printf( "%s regenerated target cache for %s (%s)",
@@ -171,7 +199,7 @@ player_t* action_t::select_target_if_target()
   std::vector<player_t*> master_list;
   if ( sim->distance_targeting_enabled )
   {
-    if ( !target_cache.is_valid )
+    if ( !target_cache.check_valid() )
     {
       available_targets( target_cache.list );
       master_list           = targets_in_range_list( target_cache.list );
@@ -283,6 +311,23 @@ double player_t::get_position_distance( double m, double v ) const
   return util::approx_sqrt( sqrtnum );
 }
 
+// player_t::set_position ======================================================
+
+// Move the actor to ( x, y ), returns true if the position changed
+
+bool player_t::set_position( double x, double y )
+{
+  bool moved = x != x_position || y != y_position;
+
+  x_position = x;
+  y_position = y;
+
+  if ( sim->distance_targeting_enabled )
+    sim->actor_grid.update( this );
+
+  return moved;
+}
+
 // player_t::get_player_distance ===============================================
 
 double player_t::get_player_distance( const player_t& target ) const
@@ -309,7 +354,94 @@ void player_t::init_distance_targeting()
   if ( !sim->distance_targeting_enabled )
     return;
 
-  x_position = -1 * base.distance;
+  set_position( -1 * base.distance, y_position );
+}
+
+// Spatial grid ==============================================================
+
+spatial_grid_t::spatial_grid_t( double cell_size ) :
+  cell_size( cell_size ), max_combat_reach( 0 ), current_stamp( 0 )
+{ }
+
+// spatial_grid_t::update ====================================================
+
+void spatial_grid_t::update( player_t* p )
+{
+  size_t index = p->actor_index;
+  uint64_t key = cell_key( cell_coord( p->x_position ), cell_coord( p->y_position ) );
+
+  if ( index >= actor_cell.size() )
+  {
+    actor_cell.resize( index + 1 );
+    in_grid.resize( index + 1, false );
+    stamp.resize( index + 1, 0 );
+  }
+
+  if ( ! in_grid[ index ] )
+  {
+    actors.push_back( p );
+    in_grid[ index ] = true;
+  }
+  else if ( actor_cell[ index ] == key )
+  {
+    return;
+  }
+  else
+  {
+    cell_t& old_cell = cells[ actor_cell[ index ] ];
+    old_cell.erase( std::find( old_cell.begin(), old_cell.end(), p ) );
+  }
+
+  actor_cell[ index ] = key;
+  cells[ key ].push_back( p );
+  max_combat_reach = std::max( max_combat_reach, p->combat_reach );
+}
+
+// spatial_grid_t::mark ======================================================
+
+void spatial_grid_t::mark( double x, double y, double distance ) const
+{
+  if ( ++current_stamp == 0 )
+  {
+    range::fill( stamp, 0 );
+    current_stamp = 1;
+  }
+
+  // Leave room for combat reach and the error of util::approx_sqrt
+  double d = ( distance + max_combat_reach ) * 1.01 + 0.01;
+  double span_x = std::floor( ( x + d ) / cell_size ) - std::floor( ( x - d ) / cell_size ) + 1;
+  double span_y = std::floor( ( y + d ) / cell_size ) - std::floor( ( y - d ) / cell_size ) + 1;
+
+  // Large areas are cheaper to check actor by actor
+  if ( span_x * span_y >= actors.size() )
+  {
+    for ( auto p : actors )
+    {
+      if ( std::fabs( p->x_position - x ) <= d && std::fabs( p->y_position - y ) <= d )
+        stamp[ p->actor_index ] = current_stamp;
+    }
+    return;
+  }
+
+  for ( int64_t cx = cell_coord( x - d ), cx_end = cell_coord( x + d ); cx <= cx_end; ++cx )
+  {
+    for ( int64_t cy = cell_coord( y - d ), cy_end = cell_coord( y + d ); cy <= cy_end; ++cy )
+    {
+      auto it = cells.find( cell_key( cx, cy ) );
+      if ( it == cells.end() )
+        continue;
+
+      for ( auto p : it->second )
+        stamp[ p->actor_index ] = current_stamp;
+    }
+  }
+}
+
+// spatial_grid_t::marked ====================================================
+
+bool spatial_grid_t::marked( const player_t* p ) const
+{
+  return p->actor_index < stamp.size() && stamp[ p->actor_index ] == current_stamp;
 }
 
 // Generic helper functions ==================================================
@@ -17,6 +17,7 @@ dot_t::dot_t( const std::string& n, player_t* t, player_t* s )
     extended_time( timespan_t::zero() ),
     reduced_time( timespan_t::zero() ),
     stack( 0 ),
+    tick_entry( this ),
     tick_event( nullptr ),
     end_event( nullptr ),
     last_tick_factor( -1.0 ),
@@ -165,7 +166,7 @@ void dot_t::reset()
   if ( ticking )
     source->remove_active_dot( state->action->internal_id );
 
-  event_t::cancel( tick_event );
+  cancel_tick_event();
   event_t::cancel( end_event );
   time_to_tick     = timespan_t::zero();
   ticking          = false;
@@ -282,7 +283,7 @@ void dot_t::copy( player_t* other_target, dot_copy_e copy_type )
 
       // Cancel target's ongoing events, we are about to re-do them
       event_t::cancel( other_dot->end_event );
-      event_t::cancel( other_dot->tick_event );
+      other_dot->cancel_tick_event();
     }
     // No target dot ticking, just copy the source's remaining time
     else
@@ -343,8 +344,7 @@ void dot_t::copy( player_t* other_target, dot_copy_e copy_type )
     else
       tick_time = other_dot->current_action->tick_time( other_dot->state );
 
-    other_dot->tick_event =
-        make_event<dot_tick_event_t>( sim, other_dot, tick_time );
+    other_dot->schedule_tick_event( tick_time );
   }
 }
 
@@ -386,7 +386,7 @@ void dot_t::copy( dot_t* other_dot )
 
     // Cancel target's ongoing events, we are about to re-do them
     event_t::cancel( other_dot->end_event );
-    event_t::cancel( other_dot->tick_event );
+    other_dot->cancel_tick_event();
   }
   // No target dot ticking, just copy the source's remaining time
   else
@@ -446,7 +446,7 @@ void dot_t::copy( dot_t* other_dot )
   else
     tick_time = other_dot->current_action->tick_time( other_dot->state );
 
-  other_dot->tick_event = make_event<dot_tick_event_t>( sim, other_dot, tick_time );
+  other_dot->schedule_tick_event( tick_time );
 }
 
 // dot_t::create_expression =================================================
@@ -1002,7 +1002,7 @@ void dot_t::schedule_tick()
   last_tick_factor =
       current_action->last_tick_factor( this, base_tick_time, remains() );
 
-  tick_event = make_event<dot_tick_event_t>( sim, this, time_to_tick );
+  schedule_tick_event( time_to_tick );
 
   if ( current_action->channeled )
   {
@@ -1064,7 +1064,25 @@ void dot_t::start( timespan_t duration )
   // Only schedule a tick if thre's enough time to tick at least once.
   // Otherwise, next tick is the last tick, and the end event will handle it
   if ( current_duration <= time_to_tick )
-    event_t::cancel( tick_event );
+    cancel_tick_event();
+}
+
+// dot_t::schedule_tick_event ==============================================
+
+void dot_t::schedule_tick_event( timespan_t time_to_tick )
+{
+  if ( sim.debug )
+    sim.out_debug.printf( "New DoT Tick Event: %s %s %d-of-%d %.4f",
+                source -> name(), name(), current_tick + 1, num_ticks, time_to_tick.total_seconds() );
+
+  source -> dot_ticks.schedule( this, time_to_tick );
+}
+
+// dot_t::cancel_tick_event ================================================
+
+void dot_t::cancel_tick_event()
+{
+  source -> dot_ticks.cancel( this );
 }
 
 /* Precondition: ticking == true
@@ -1114,7 +1132,7 @@ void dot_t::refresh( timespan_t duration )
   if ( !tick_event )
   {
     assert( !current_action->channeled );
-    tick_event = make_event<dot_tick_event_t>( sim, this, remaining_duration );
+    schedule_tick_event( remaining_duration );
   }
 }
 
@@ -1193,12 +1211,240 @@ void dot_t::adjust( double coefficient )
         ( sim->current_time() + new_dot_remains ).total_seconds() );
   }
 
-  event_t::cancel( tick_event );
+  cancel_tick_event();
   event_t::cancel( end_event );
 
   current_duration = new_duration;
   time_to_tick     = time_to_tick * coefficient;
-  tick_event       = make_event<dot_tick_event_t>( *sim, this, new_tick_remains );
+  schedule_tick_event( new_tick_remains );
   //end_event        = new ( *sim ) dot_end_event_t( this, new_dot_remains );
   end_event = make_event<dot_end_event_t>(*sim, this, new_dot_remains );
 }
+
+// ==========================================================================
+// Dot Tick Scheduler
+// ==========================================================================
+
+// dot_tick_t::reschedule ===================================================
+
+void dot_tick_t::reschedule( timespan_t delta_time )
+{
+  sim_t* sim = dot -> source -> sim;
+  delta_time += sim -> current_time();
+
+  if ( sim -> debug )
+  {
+    if ( reschedule_time == timespan_t::zero() )
+      sim -> out_debug.printf( "Rescheduling tick of %s (%d) from %.2f to %.2f",
+                               dot -> name(), id, time.total_seconds(),
+                               delta_time.total_seconds() );
+    else
+      sim -> out_debug.printf(
+          "Adjusting reschedule of tick of %s (%d) from %.2f to %.2f time=%.2f",
+          dot -> name(), id, reschedule_time.total_seconds(),
+          delta_time.total_seconds(), time.total_seconds() );
+  }
+
+  reschedule_time = delta_time;
+}
+
+dot_tick_scheduler_t::dot_tick_scheduler_t( player_t* p ) :
+  player( p ), event( nullptr ), executing( false )
+{ }
+
+// dot_tick_scheduler_t::schedule ===========================================
+
+void dot_tick_scheduler_t::schedule( dot_t* dot, timespan_t delta_time )
+{
+  if ( dot -> tick_event )
+    remove( dot -> tick_event );
+
+  // Consume an event id exactly as a tick event of its own would, so the ordering of ticks against
+  // all other events is unchanged.
+  dot_tick_t* tick = &( dot -> tick_entry );
+  tick -> id = player -> sim -> event_mgr.assign_event_time( delta_time, tick -> time, tick -> reschedule_time );
+  dot -> tick_event = tick;
+
+  push( tick );
+  update_event();
+}
+
+// dot_tick_scheduler_t::cancel =============================================
+
+void dot_tick_scheduler_t::cancel( dot_t* dot )
+{
+  if ( ! dot -> tick_event )
+    return;
+
+  remove( dot -> tick_event );
+  dot -> tick_event = nullptr;
+  update_event();
+}
+
+// dot_tick_scheduler_t::execute ============================================
+
+void dot_tick_scheduler_t::execute()
+{
+  event = nullptr;
+
+  dot_tick_t* tick = heap.front();
+  assert( tick -> time == player -> sim -> current_time() );
+
+  // Rescheduled tick, re-add it with a new id just like the event manager does for events
+  if ( tick -> reschedule_time > tick -> time )
+  {
+    if ( player -> sim -> debug )
+      player -> sim -> out_debug.printf( "Reschedule Tick: %s %d", tick -> dot -> name(), tick -> id );
+
+    remove( tick );
+    tick -> id = player -> sim -> event_mgr.assign_event_time( tick -> reschedule_time - player -> sim -> current_time(),
+                                                               tick -> time, tick -> reschedule_time );
+    push( tick );
+    update_event();
+    return;
+  }
+
+  remove( tick );
+
+  dot_t* dot = tick -> dot;
+  dot -> tick_event = nullptr;
+
+  // Changes to the heap by the tick are picked up once it is done
+  executing = true;
+
+  dot -> current_tick++;
+
+  if ( dot -> current_action -> channeled &&
+       dot -> current_action -> action_skill < 1.0 &&
+       dot -> remains() >= dot -> current_action -> tick_time( dot -> state ) )
+  {
+    if ( player -> sim -> rng().roll( std::max( 0.0, dot -> current_action -> action_skill - dot -> current_action -> player -> current.skill_debuff ) ) )
+    {
+      dot -> tick();
+    }
+  }
+  else // No skill-check required
+  {
+    dot -> tick();
+  }
+
+  // Some dots actually cancel themselves mid-tick. If this happens, we presume
+  // that the cancel has been "proper", and just stop tick execution here, as
+  // the dot no longer exists. Otherwise, continue ticking unless the tick cost
+  // could not be paid, or the channel was interrupted.
+  if ( dot -> is_ticking() &&
+       dot -> current_action -> consume_cost_per_tick( *dot ) &&
+       ! dot -> channel_interrupt() )
+  {
+    dot -> schedule_tick();
+  }
+
+  executing = false;
+  update_event();
+}
+
+// dot_tick_scheduler_t::reset ==============================================
+
+void dot_tick_scheduler_t::reset()
+{
+  for ( auto tick : heap )
+    tick -> dot -> tick_event = nullptr;
+
+  heap.clear();
+  event = nullptr;
+  executing = false;
+}
+
+// dot_tick_scheduler_t::update_event =======================================
+
+void dot_tick_scheduler_t::update_event()
+{
+  if ( executing )
+    return;
+
+  if ( heap.empty() )
+  {
+    event_t::cancel( event );
+    return;
+  }
+
+  const dot_tick_t* next = heap.front();
+  if ( event && event -> time == next -> time && event -> id == next -> id )
+    return;
+
+  event_t::cancel( event );
+  event = make_event<dot_tick_event_t>( *player -> sim, player, *this, *next );
+}
+
+// dot_tick_scheduler_t::push ===============================================
+
+void dot_tick_scheduler_t::push( dot_tick_t* tick )
+{
+  heap.push_back( tick );
+  sift_up( heap.size() - 1 );
+}
+
+// dot_tick_scheduler_t::remove =============================================
+
+void dot_tick_scheduler_t::remove( dot_tick_t* tick )
+{
+  size_t idx = tick -> heap_index;
+  assert( idx < heap.size() && heap[ idx ] == tick );
+
+  dot_tick_t* last = heap.back();
+  heap.pop_back();
+  if ( last == tick )
+    return;
+
+  place( idx, last );
+  sift_up( idx );
+  sift_down( last -> heap_index );
+}
+
+// dot_tick_scheduler_t::sift_up ============================================
+
+void dot_tick_scheduler_t::sift_up( size_t idx )
+{
+  dot_tick_t* tick = heap[ idx ];
+  while ( idx > 0 )
+  {
+    size_t parent = ( idx - 1 ) / 2;
+    if ( ! before( tick, heap[ parent ] ) )
+      break;
+
+    place( idx, heap[ parent ] );
+    idx = parent;
+  }
+  place( idx, tick );
+}
+
+// dot_tick_scheduler_t::sift_down ==========================================
+
+void dot_tick_scheduler_t::sift_down( size_t idx )
+{
+  dot_tick_t* tick = heap[ idx ];
+  while ( true )
+  {
+    size_t child = 2 * idx + 1;
+    if ( child >= heap.size() )
+      break;
+
+    if ( child + 1 < heap.size() && before( heap[ child + 1 ], heap[ child ] ) )
+      child++;
+
+    if ( ! before( heap[ child ], tick ) )
+      break;
+
+    place( idx, heap[ child ] );
+    idx = child;
+  }
+  place( idx, tick );
+}
+
+// dot_tick_scheduler_t::place ==============================================
+
+void dot_tick_scheduler_t::place( size_t idx, dot_tick_t* tick )
+{
+  heap[ idx ] = tick;
+  tick -> heap_index = idx;
+}
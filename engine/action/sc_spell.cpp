@@ -5,22 +5,6 @@
 
 #include "simulationcraft.hpp"
 
-namespace {
-
-struct aoe_player_list_callback_t
-{
-  action_t* action;
-  aoe_player_list_callback_t( action_t* a ) : action( a ) {}
-
-  void operator()(player_t*)
-  {
-    // Invalidate target cache
-    action -> target_cache.is_valid = false;
-  }
-};
-
-} // unnamed namespace
-
 // ==========================================================================
 // Spell Base
 // ==========================================================================
@@ -245,7 +229,7 @@ heal_t::heal_t( const std::string&  token,
 void heal_t::init_target_cache()
 {
   if ( aoe )
-    sim -> player_non_sleeping_list.register_callback( aoe_player_list_callback_t( this ) );
+    target_cache.source = &( sim -> player_non_sleeping_list );
 }
 
 // heal_t::parse_effect_data ================================================
@@ -413,7 +397,7 @@ void heal_t::assess_damage( dmg_e heal_type,
     proc_types pt = s -> proc_type();
     proc_types2 pt2 = s -> impact_proc_type2();
     if ( pt != PROC1_INVALID && pt2 != PROC2_INVALID )
-      action_callback_t::trigger( player -> callbacks.procs[ pt ][ pt2 ], this, s );
+      player -> callbacks.trigger( pt, pt2, this, s );
   }
 
   if ( player -> record_healing() )
@@ -637,7 +621,7 @@ absorb_t::absorb_t( const std::string&  token,
 void absorb_t::init_target_cache()
 {
   if ( aoe )
-    sim -> player_non_sleeping_list.register_callback( aoe_player_list_callback_t( this ) );
+    target_cache.source = &( sim -> player_non_sleeping_list );
 }
 
 // absorb_t::execute ========================================================
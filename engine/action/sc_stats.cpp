@@ -26,6 +26,7 @@ stats_t::stats_t( const std::string& n, player_t* p ) :
   iteration_total_execute_time( timespan_t::zero() ),
   iteration_total_tick_time( timespan_t::zero() ),
   portion_amount( 0 ),
+  iteration_actual_amount( 0 ),
   total_intervals(),
   last_execute( timespan_t::min() ),
   actual_amount( name_str + " Actual Amount", p -> sim -> statistics_level < 3 ),
@@ -196,6 +197,7 @@ void stats_t::datacollection_begin()
   iteration_num_refreshes = 0;
   iteration_total_execute_time = timespan_t::zero();
   iteration_total_tick_time = timespan_t::zero();
+  iteration_actual_amount = 0;
 
   for ( result_e i = RESULT_NONE; i < RESULT_MAX; i++ )
   {
@@ -236,6 +238,7 @@ void stats_t::datacollection_end()
     tick_results_detail[ i ].datacollection_end();
   }
 
+  iteration_actual_amount = iaa;
   actual_amount.add( iaa );
   total_amount.add( ita );
 
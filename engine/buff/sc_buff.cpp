@@ -201,6 +201,7 @@ buff_t::buff_t( const buff_creation::buff_creator_basics_t& params ) :
   trigger_attempts(),
   trigger_successes(),
   simulation_max_stack( 0 ),
+  iteration_max_stack( 0 ),
   benefit_pct(),
   trigger_pct(),
   avg_start(),
@@ -215,7 +216,7 @@ buff_t::buff_t( const buff_creation::buff_creator_basics_t& params ) :
 {
   if ( source ) // Player Buffs
   {
-    player -> buff_list.push_back( this );
+    player -> register_buff( this );
     cooldown = source -> get_cooldown( "buff_" + name_str );
   }
   else // Sim Buffs
@@ -481,8 +482,13 @@ void buff_t::datacollection_begin()
   overflow_count = 0;
   overflow_total = 0;
 
-  for ( int i = 0; i <= simulation_max_stack; i++ )
+  // Sparse collection only samples the stack levels reached in the iteration, so only those can
+  // hold uptime from the previous one
+  int max_stack = sim -> sparse_buff_data ? std::min( iteration_max_stack, simulation_max_stack ) : simulation_max_stack;
+  for ( int i = 0; i <= max_stack; i++ )
     stack_uptime[ i ].datacollection_begin();
+
+  iteration_max_stack = current_stack;
 }
 
 // buff_t::datacollection_end ===============================================
@@ -491,9 +497,23 @@ void buff_t::datacollection_end()
 {
   timespan_t time = player ? player -> iteration_fight_length : sim -> current_time();
 
+  // Every sample of an iteration where the buff was never up, triggered or expired is zero. Sparse
+  // collection skips those iterations, analyze() adds the zero samples back.
+  int max_stack = simulation_max_stack;
+  if ( sim -> sparse_buff_data )
+  {
+    stack_uptime[ simulation_max_stack ].max_stack_iterations++;
+
+    if ( iteration_uptime_sum == timespan_t::zero() && up_count == 0 && trigger_successes == 0 &&
+         start_count == 0 && refresh_count == 0 && expire_count == 0 && overflow_count == 0 )
+      return;
+
+    max_stack = std::min( iteration_max_stack, simulation_max_stack );
+  }
+
   uptime_pct.add( time != timespan_t::zero() ? 100.0 * iteration_uptime_sum / time : 0 );
 
-  for ( int i = 0; i <= simulation_max_stack; i++ )
+  for ( int i = 0; i <= max_stack; i++ )
     stack_uptime[ i ].datacollection_end( time );
 
   double benefit = up_count > 0 ? 100.0 * up_count / ( up_count + down_count ) :
@@ -1172,6 +1192,9 @@ void buff_t::bump( int stacks, double value )
 
     if ( current_stack > simulation_max_stack )
       simulation_max_stack = current_stack;
+
+    if ( current_stack > iteration_max_stack )
+      iteration_max_stack = current_stack;
   }
   else
   {
@@ -1418,6 +1441,27 @@ void buff_t::merge( const buff_t& other )
 
 void buff_t::analyze()
 {
+  // Fold in the zero samples of the iterations skipped by sparse collection. Like in full
+  // collection, a stack level is sampled from the iteration it was first reached in on, so its
+  // sample count is the number of iterations that ended with at least that maximum stack.
+  if ( sim -> sparse_buff_data )
+  {
+    size_t iterations = 0;
+    for ( size_t i = stack_uptime.size(); i > 0; i-- )
+    {
+      iterations += stack_uptime[ i - 1 ].max_stack_iterations;
+      simple_sample_data_t& data = stack_uptime[ i - 1 ].uptime_sum;
+      assert( data.count() <= iterations );
+      data.add_zeros( iterations - data.count() );
+    }
+
+    for ( auto data : { &uptime_pct, &benefit_pct, &trigger_pct, &avg_start, &avg_refresh, &avg_expire,
+                        &avg_overflow_count, &avg_overflow_total } )
+    {
+      assert( data -> count() <= iterations );
+      data -> add_zeros( iterations - data -> count() );
+    }
+  }
 
   if ( sim -> buff_uptime_timeline )
     uptime_array.adjust( *sim );
@@ -1501,6 +1545,16 @@ buff_t* buff_t::find_expressable( const std::vector<buff_t*>& buffs,
     return find( buffs, name, source );
 }
 
+buff_t* buff_t::find_expressable( player_t* p,
+                                  const std::string& name,
+                                  player_t* source )
+{
+  if ( util::str_compare_ci( "potion", name ) )
+    return find_potion_buff( p -> buff_list, source );
+  else
+    return find( p, name, source );
+}
+
 // buff_t::to_str ===========================================================
 
 std::string buff_t::to_str() const
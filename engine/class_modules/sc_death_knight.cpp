@@ -736,8 +736,8 @@ public:
   // Pets and Guardians
   struct pets_t
   {
-    std::array< pets::death_knight_pet_t*, 8 > army_ghoul;
-    std::array< pets::death_knight_pet_t*, 8 > apocalypse_ghoul;
+    pet_pool_t< pets::death_knight_pet_t > army_ghoul;
+    pet_pool_t< pets::death_knight_pet_t > apocalypse_ghoul;
     pets::dancing_rune_weapon_pet_t* dancing_rune_weapon;
     pets::dt_pet_t* ghoul_pet; // Covers both Ghoul and Sludge Belcher
     pets::death_knight_pet_t* gargoyle;
@@ -809,8 +809,6 @@ public:
     legendary( legendary_t() ),
     _runes( this )
   {
-    range::fill( pets.army_ghoul, nullptr );
-
     cooldown.antimagic_shell = get_cooldown( "antimagic_shell" );
     cooldown.avalanche       = get_cooldown( "avalanche" );
     cooldown.bone_shield_icd = get_cooldown( "bone_shield_icd" );
@@ -904,7 +902,7 @@ public:
     death_knight_td_t*& td = target_data[ target ];
     if ( ! td )
     {
-      td = new death_knight_td_t( target, const_cast<death_knight_t*>(this) );
+      td = target_data.create( target, target, const_cast<death_knight_t*>(this) );
     }
     return td;
   }
@@ -3358,7 +3356,7 @@ struct army_of_the_dead_t : public death_knight_spell_t
 
   virtual bool ready() override
   {
-    if ( p() -> pets.army_ghoul[ 0 ] && ! p() -> pets.army_ghoul[ 0 ] -> is_sleeping() )
+    if ( ! p() -> pets.army_ghoul.empty() && ! p() -> pets.army_ghoul[ 0 ] -> is_sleeping() )
       return false;
 
     return death_knight_spell_t::ready();
@@ -6553,7 +6551,7 @@ void death_knight_t::create_pets()
     {
       for ( int i = 0; i < 8; i++ )
       {
-        pets.army_ghoul[ i ] = new pets::army_pet_t( this, "army_ghoul" );
+        pets.army_ghoul.add( new pets::army_pet_t( this, "army_ghoul" ) );
       }
     }
 
@@ -6561,7 +6559,7 @@ void death_knight_t::create_pets()
     {
       for ( auto i = 0; i < 8; i++ )
       {
-        pets.apocalypse_ghoul[ i ] = new pets::army_pet_t( this, "apocalypse_ghoul" );
+        pets.apocalypse_ghoul.add( new pets::army_pet_t( this, "apocalypse_ghoul" ) );
       }
     }
   }
@@ -5337,6 +5337,9 @@ demon_hunter_t::demon_hunter_t( sim_t* sim, const std::string& name, race_e r )
   create_benefits();
 
   regen_type = REGEN_DISABLED;
+
+  cache_invalidation_notify.set( CACHE_ATTACK_POWER );
+  cache_invalidation_notify.set( CACHE_DAMAGE_VERSATILITY );
 }
 
 demon_hunter_t::~demon_hunter_t()
@@ -7677,7 +7680,7 @@ demon_hunter_td_t* demon_hunter_t::get_target_data( player_t* target ) const
   auto& td = _target_data[ target ];
   if ( !td )
   {
-    td = new demon_hunter_td_t( target, const_cast<demon_hunter_t&>( *this ) );
+    td = _target_data.create( target, target, const_cast<demon_hunter_t&>( *this ) );
   }
   return td;
 }
@@ -764,6 +764,8 @@ public:
     regen_type = REGEN_DYNAMIC;
     regen_caches[ CACHE_HASTE ] = true;
     regen_caches[ CACHE_ATTACK_HASTE ] = true;
+
+    cache_invalidation_notify.set( CACHE_ATTACK_POWER );
   }
 
   virtual           ~druid_t();
@@ -8505,7 +8507,7 @@ druid_td_t* druid_t::get_target_data( player_t* target ) const
   druid_td_t*& td = target_data[ target ];
   if ( ! td )
   {
-    td = new druid_td_t( *target, const_cast<druid_t&>( *this ) );
+    td = target_data.create( target, *target, const_cast<druid_t&>( *this ) );
   }
   return td;
 }
@@ -1554,6 +1554,9 @@ void enemy_t::recalculate_health()
 {
   if ( sim -> expected_iteration_time <= timespan_t::zero() || fixed_health > 0 ) return;
 
+  // Health is calibrated once, in the warm-up iteration that every thread runs identically
+  if ( sim -> deterministic_iterations && sim -> global_iteration >= 0 ) return;
+
   if ( initial_health == 0 ) // first iteration
   {
     initial_health = iteration_dmg_taken * ( sim -> expected_iteration_time / sim -> current_time() ) * ( 1.0 / ( 1.0 - death_pct / 100 ) );
@@ -619,7 +619,7 @@ public:
     mage_td_t*& td = target_data[ target ];
     if ( ! td )
     {
-      td = new mage_td_t( target, const_cast<mage_t*>(this) );
+      td = target_data.create( target, target, const_cast<mage_t*>(this) );
     }
     return td;
   }
@@ -847,7 +847,7 @@ struct water_elemental_pet_t : public mage_pet_t
   {
     water_elemental_pet_td_t*& td = target_data[ target ];
     if ( !td )
-      td = new water_elemental_pet_td_t(
+      td = target_data.create( target,
           target, const_cast<water_elemental_pet_t*>( this ) );
     return td;
   }
@@ -7270,6 +7270,8 @@ mage_t::mage_t( sim_t* sim, const std::string& name, race_e r ) :
   regen_type = REGEN_DYNAMIC;
   regen_caches[ CACHE_MASTERY ] = true;
 
+  cache_invalidation_notify.set( CACHE_SPELL_CRIT_CHANCE );
+
 }
 
 
@@ -724,6 +724,7 @@ public:
       regen_caches[CACHE_HASTE] = true;
       regen_caches[CACHE_ATTACK_HASTE] = true;
     }
+    cache_invalidation_notify.set( CACHE_SPELL_POWER );
     user_options.initial_chi = 0;
   }
 
@@ -784,7 +785,7 @@ public:
     monk_td_t*& td = target_data[target];
     if ( !td )
     {
-      td = new monk_td_t( target, const_cast<monk_t*>( this ) );
+      td = target_data.create( target, target, const_cast<monk_t*>( this ) );
     }
     return td;
   }
@@ -1701,7 +1702,7 @@ public:
     sef_td_t*& td = target_data[ target ];
     if ( ! td )
     {
-      td = new sef_td_t( target, const_cast< storm_earth_and_fire_pet_t*>( this ) );
+      td = target_data.create( target, target, const_cast< storm_earth_and_fire_pet_t*>( this ) );
     }
     return td;
   }
@@ -2733,7 +2734,7 @@ struct windwalking_aura_t: public monk_spell_t
     return tl.size();
   }
 
-  std::vector<player_t*> check_distance_targeting( std::vector< player_t* >& tl ) const override
+  std::vector<player_t*>& check_distance_targeting( std::vector< player_t* >& tl ) const override
   {
     size_t i = tl.size();
     while ( i > 0 )
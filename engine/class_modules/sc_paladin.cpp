@@ -422,6 +422,9 @@ public:
 
     beacon_target = nullptr;
     regen_type = REGEN_DYNAMIC;
+
+    cache_invalidation_notify.set( CACHE_ATTACK_POWER );
+    cache_invalidation_notify.set( CACHE_ATTACK_CRIT_CHANCE );
   }
 
   virtual void      init_base_stats() override;
@@ -507,7 +510,7 @@ public:
     paladin_td_t*& td = target_data[ target ];
     if ( ! td )
     {
-      td = new paladin_td_t( target, const_cast<paladin_t*>(this) );
+      td = target_data.create( target, target, const_cast<paladin_t*>(this) );
     }
     return td;
   }
@@ -2875,7 +2875,7 @@ struct sphere_of_insanity_spell_t final : public priest_spell_t
   std::vector<player_t*>& target_list() const
   {
     // Check if target cache is still valid. If not, recalculate it
-    if ( !target_cache.is_valid )
+    if ( !target_cache.check_valid() )
     {
       std::vector<player_t*> targets;
       range::for_each( sim->target_non_sleeping_list,
@@ -5769,7 +5769,7 @@ priest_td_t* priest_t::get_target_data( player_t* target ) const
   priest_td_t*& td = _target_data[ target ];
   if ( !td )
   {
-    td = new priest_td_t( target, const_cast<priest_t&>( *this ) );
+    td = _target_data.create( target, target, const_cast<priest_t&>( *this ) );
   }
   return td;
 }
@@ -697,7 +697,7 @@ struct rogue_t : public player_t
     rogue_td_t*& td = target_data[ target ];
     if ( ! td )
     {
-      td = new rogue_td_t( target, const_cast<rogue_t*>(this) );
+      td = target_data.create( target, target, const_cast<rogue_t*>(this) );
     }
     return td;
   }
@@ -29,7 +29,7 @@ namespace { // UNNAMED NAMESPACE
   of attempts, in which it gives up and just returns the current best path.  I wouldn't be
   terribly surprised if Blizz did something like this in game.
 **/
-static std::vector<player_t*> __check_distance_targeting( const action_t* action, std::vector< player_t* >& tl )
+static std::vector<player_t*>& __check_distance_targeting( const action_t* action, std::vector< player_t* >& tl )
 {
   sim_t* sim = action -> sim;
   player_t* target = action -> target;
@@ -570,6 +570,8 @@ public:
     hailstorm   = nullptr;
 
     regen_type = REGEN_DISABLED;
+
+    cache_invalidation_notify.set( CACHE_ATTACK_POWER );
   }
 
   virtual           ~shaman_t();
@@ -652,7 +654,7 @@ public:
     shaman_td_t*& td = target_data[ target ];
     if ( ! td )
     {
-      td = new shaman_td_t( target, const_cast<shaman_t*>(this) );
+      td = target_data.create( target, target, const_cast<shaman_t*>(this) );
     }
     return td;
   }
@@ -3823,7 +3825,7 @@ struct chained_overload_base_t: public elemental_overload_spell_t
     return m;
   }
 
-  std::vector<player_t*> check_distance_targeting( std::vector< player_t* >& tl ) const override
+  std::vector<player_t*>& check_distance_targeting( std::vector< player_t* >& tl ) const override
   {
     return __check_distance_targeting( this, tl );
   }
@@ -3923,7 +3925,7 @@ struct chained_base_t : public shaman_spell_t
     p() -> trigger_lightning_rod_damage( state );
   }
 
-  std::vector<player_t*> check_distance_targeting( std::vector< player_t* >& tl ) const override
+  std::vector<player_t*>& check_distance_targeting( std::vector< player_t* >& tl ) const override
   {
     return __check_distance_targeting( this, tl );
   }
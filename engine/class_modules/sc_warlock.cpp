@@ -123,14 +123,14 @@ public:
     static const int DOOMGUARD_LIMIT = 1;
     static const int LORD_OF_FLAMES_INFERNAL_LIMIT = 3;
     static const int DARKGLARE_LIMIT = 1;
-    std::array<pets::wild_imp_pet_t*, WILD_IMP_LIMIT> wild_imps;
+    pet_pool_t<pets::wild_imp_pet_t> wild_imps;
     std::array<pets::t18_illidari_satyr_t*, T18_PET_LIMIT> t18_illidari_satyr;
     std::array<pets::t18_prince_malchezaar_t*, T18_PET_LIMIT> t18_prince_malchezaar;
     std::array<pets::t18_vicious_hellhound_t*, T18_PET_LIMIT> t18_vicious_hellhound;
     std::array<pets::shadowy_tear::shadowy_tear_t*, DIMENSIONAL_RIFT_LIMIT> shadowy_tear;
     std::array<pets::chaos_tear_t*, DIMENSIONAL_RIFT_LIMIT> chaos_tear;
     std::array<pets::chaos_portal::chaos_portal_t*, DIMENSIONAL_RIFT_LIMIT> chaos_portal;
-    std::array<pets::dreadstalker_t*, DREADSTALKER_LIMIT> dreadstalkers;
+    pet_pool_t<pets::dreadstalker_t> dreadstalkers;
     std::array<pets::infernal_t*, INFERNAL_LIMIT> infernal;
     std::array<pets::doomguard_t*, DOOMGUARD_LIMIT> doomguard;
     std::array<pets::lord_of_flames_infernal_t*, LORD_OF_FLAMES_INFERNAL_LIMIT> lord_of_flames_infernal;
@@ -538,7 +538,7 @@ public:
     warlock_td_t*& td = target_data[target];
     if ( ! td )
     {
-      td = new warlock_td_t( target, const_cast<warlock_t&>( *this ) );
+      td = target_data.create( target, target, const_cast<warlock_t&>( *this ) );
     }
     return td;
   }
@@ -1665,7 +1665,7 @@ namespace shadowy_tear {
     {
       shadowy_tear_td_t*& td = target_data[target];
       if ( !td )
-        td = new shadowy_tear_td_t( target, const_cast< shadowy_tear_t* >( this ) );
+        td = target_data.create( target, target, const_cast< shadowy_tear_t* >( this ) );
       return td;
     }
 
@@ -1738,7 +1738,7 @@ namespace chaos_portal {
     {
       chaos_portal_td_t*& td = target_data[target];
       if ( !td )
-        td = new chaos_portal_td_t( target, const_cast< chaos_portal_t* >( this ) );
+        td = target_data.create( target, target, const_cast< chaos_portal_t* >( this ) );
       return td;
     }
 
@@ -2056,7 +2056,7 @@ struct dreadstalker_t : public warlock_pet_t
     resources.base[RESOURCE_ENERGY] = 0;
     base_energy_regen_per_second = 0;
     melee_attack = new warlock_pet_melee_t( this );
-    if ( o() -> warlock_pet_list.dreadstalkers[0] )
+    if ( ! o() -> warlock_pet_list.dreadstalkers.empty() )
       melee_attack -> stats = o() ->warlock_pet_list.dreadstalkers[0] -> get_stats( "melee" );
   }
 
@@ -2355,7 +2355,7 @@ public:
   {
     if ( use_havoc() )
     {
-      if ( ! target_cache.is_valid )
+      if ( ! target_cache.check_valid() )
         available_targets( target_cache.list );
 
       havoc_targets.clear();
@@ -2569,21 +2569,17 @@ public:
 
   static void trigger_wild_imp( warlock_t* p, bool doge = false, int duration = 12001 )
   {
-    for ( size_t i = 0; i < p -> warlock_pet_list.wild_imps.size(); i++ )
+    if ( pets::wild_imp_pet_t* imp = p -> warlock_pet_list.wild_imps.idle() )
     {
-      if ( p -> warlock_pet_list.wild_imps[i] -> is_sleeping() )
+      imp -> trigger(duration, doge);
+      p -> procs.wild_imp -> occur();
+      if( p -> legendary.wilfreds_sigil_of_superior_summoning_flag && !p -> talents.grimoire_of_supremacy -> ok() )
       {
-
-        p -> warlock_pet_list.wild_imps[i] -> trigger(duration, doge);
-        p -> procs.wild_imp -> occur();
-        if( p -> legendary.wilfreds_sigil_of_superior_summoning_flag && !p -> talents.grimoire_of_supremacy -> ok() )
-        {
-            p -> cooldowns.doomguard -> adjust( p -> legendary.wilfreds_sigil_of_superior_summoning );
-            p -> cooldowns.infernal -> adjust( p -> legendary.wilfreds_sigil_of_superior_summoning );
-            p -> procs.wilfreds_imp -> occur();
-        }
-        return;
+          p -> cooldowns.doomguard -> adjust( p -> legendary.wilfreds_sigil_of_superior_summoning );
+          p -> cooldowns.infernal -> adjust( p -> legendary.wilfreds_sigil_of_superior_summoning );
+          p -> procs.wilfreds_imp -> occur();
       }
+      return;
     }
     //p -> sim -> errorf( "Playerd %s ran out of wild imps.\n", p -> name() );
     //assert( false ); // Will only get here if there are no available imps
@@ -4662,21 +4658,17 @@ struct call_dreadstalkers_t : public warlock_spell_t
   {
     warlock_spell_t::execute();
 
-    int j = 0;
-
-    for ( size_t i = 0; i < p() -> warlock_pet_list.dreadstalkers.size(); i++ )
+    for ( int j = 0; j < dreadstalker_count; j++ )
     {
-      if ( p() -> warlock_pet_list.dreadstalkers[i] -> is_sleeping() )
+      if ( ! p() -> warlock_pet_list.dreadstalkers.spawn( dreadstalker_duration ) )
+        break;
+
+      p() -> procs.dreadstalker_debug -> occur();
+      if(p()->legendary.wilfreds_sigil_of_superior_summoning_flag && !p()->talents.grimoire_of_supremacy->ok())
       {
-        p() -> warlock_pet_list.dreadstalkers[i] -> summon( dreadstalker_duration );
-        p() -> procs.dreadstalker_debug -> occur();
-        if(p()->legendary.wilfreds_sigil_of_superior_summoning_flag && !p()->talents.grimoire_of_supremacy->ok())
-        {
-            p()->cooldowns.doomguard->adjust(p()->legendary.wilfreds_sigil_of_superior_summoning);
-            p()->cooldowns.infernal->adjust(p()->legendary.wilfreds_sigil_of_superior_summoning);
-            p()->procs.wilfreds_dog->occur();
-        }
-        if ( ++j == dreadstalker_count ) break;
+          p()->cooldowns.doomguard->adjust(p()->legendary.wilfreds_sigil_of_superior_summoning);
+          p()->cooldowns.infernal->adjust(p()->legendary.wilfreds_sigil_of_superior_summoning);
+          p()->procs.wilfreds_dog->occur();
       }
     }
 
@@ -5958,15 +5950,15 @@ void warlock_t::create_pets()
 
   if ( specialization() == WARLOCK_DEMONOLOGY )
   {
-    for ( size_t i = 0; i < warlock_pet_list.wild_imps.size(); i++ )
+    for ( int i = 0; i < pets_t::WILD_IMP_LIMIT; i++ )
     {
-      warlock_pet_list.wild_imps[ i ] = new pets::wild_imp_pet_t( sim, this );
+      warlock_pet_list.wild_imps.add( new pets::wild_imp_pet_t( sim, this ) );
       if ( i > 0 )
         warlock_pet_list.wild_imps[ i ] -> quiet = 1;
     }
-    for ( size_t i = 0; i < warlock_pet_list.dreadstalkers.size(); i++ )
+    for ( int i = 0; i < pets_t::DREADSTALKER_LIMIT; i++ )
     {
-      warlock_pet_list.dreadstalkers[ i ] = new pets::dreadstalker_t( sim, this );
+      warlock_pet_list.dreadstalkers.add( new pets::dreadstalker_t( sim, this ) );
     }
     for ( size_t i = 0; i < warlock_pet_list.darkglare.size(); i++ )
     {
@@ -254,6 +254,277 @@ unsigned school_str_to_mask( const std::string& str )
   return mask;
 }
 
+// Index of the lowest set bit of a non-zero word
+unsigned lowest_bit( uint64_t word )
+{
+#if defined( SC_GCC ) || defined( SC_CLANG )
+  return static_cast<unsigned>( __builtin_ctzll( word ) );
+#else
+  unsigned n = 0;
+  for ( ; ! ( word & 1 ); word >>= 1 )
+    ++n;
+  return n;
+#endif
+}
+
+// Set of data ids as a bitmap over the id range. Spell query terms are
+// combined with word-wise bitmap operations instead of merging id lists.
+class id_bitmap_t
+{
+  std::vector<uint64_t> words;
+
+public:
+  id_bitmap_t()
+  { }
+
+  explicit id_bitmap_t( const std::vector<uint32_t>& ids )
+  {
+    for ( auto id : ids )
+      insert( id );
+  }
+
+  void insert( uint32_t id )
+  {
+    size_t word = id / 64;
+    if ( word >= words.size() )
+      words.resize( word + 1 );
+    words[ word ] |= uint64_t( 1 ) << ( id % 64 );
+  }
+
+  bool contains( uint32_t id ) const
+  {
+    size_t word = id / 64;
+    return word < words.size() && ( ( words[ word ] >> ( id % 64 ) ) & 1 );
+  }
+
+  id_bitmap_t& operator&=( const id_bitmap_t& other )
+  {
+    if ( words.size() > other.words.size() )
+      words.resize( other.words.size() );
+    for ( size_t i = 0; i < words.size(); ++i )
+      words[ i ] &= other.words[ i ];
+    return *this;
+  }
+
+  id_bitmap_t& operator|=( const id_bitmap_t& other )
+  {
+    if ( words.size() < other.words.size() )
+      words.resize( other.words.size() );
+    for ( size_t i = 0; i < other.words.size(); ++i )
+      words[ i ] |= other.words[ i ];
+    return *this;
+  }
+
+  id_bitmap_t& operator-=( const id_bitmap_t& other )
+  {
+    for ( size_t i = 0, end = std::min( words.size(), other.words.size() ); i < end; ++i )
+      words[ i ] &= ~other.words[ i ];
+    return *this;
+  }
+
+  // Ids of the set in ascending order
+  std::vector<uint32_t> ids() const
+  {
+    std::vector<uint32_t> res;
+    for ( size_t i = 0; i < words.size(); ++i )
+    {
+      for ( uint64_t word = words[ i ]; word; word &= word - 1 )
+        res.push_back( static_cast<uint32_t>( i * 64 + lowest_bit( word ) ) );
+    }
+    return res;
+  }
+};
+
+uint64_t field_key( const char* data, size_t offset, sdata_field_type_t type )
+{
+  switch ( type )
+  {
+    case SD_TYPE_INT:      return static_cast<uint64_t>( static_cast<int64_t>( *reinterpret_cast<const int*>( data + offset ) ) );
+    case SD_TYPE_UNSIGNED: return *reinterpret_cast<const unsigned*>( data + offset );
+    case SD_TYPE_UINT64:   return *reinterpret_cast<const uint64_t*>( data + offset );
+    default:               return 0;
+  }
+}
+
+// Key of a numeric query operand, converted like spell_data_filter_expr_t::compare does
+uint64_t value_key( double value, sdata_field_type_t type )
+{
+  switch ( type )
+  {
+    case SD_TYPE_INT:      return static_cast<uint64_t>( static_cast<int64_t>( static_cast<int>( value ) ) );
+    case SD_TYPE_UNSIGNED: return static_cast<unsigned>( value );
+    case SD_TYPE_UINT64:   return static_cast<uint64_t>( value );
+    default:               return 0;
+  }
+}
+
+// Precomputed indexes over the spell data of one client version (live or
+// ptr), shared by all spell queries of the process. The sorted id lists of
+// the tables are built with the index, an equality index of a field or the
+// bit index of a mask the first time a query filters on it. Every index is a
+// single pass over its table.
+struct spell_query_index_t
+{
+  enum table_e
+  {
+    TABLE_SPELL = 0,
+    TABLE_TALENT,
+    TABLE_EFFECT,
+    TABLE_SPELL_EFFECT // Effect fields, indexing the spell ids of the effects
+  };
+
+  enum mask_e
+  {
+    MASK_CLASS = 0,
+    MASK_TALENT_CLASS,
+    MASK_RACE,
+    MASK_SCHOOL,
+    MASK_ATTRIBUTE
+  };
+
+  typedef std::unordered_map<uint64_t, std::vector<uint32_t>> field_index_t;
+  typedef std::vector<std::vector<uint32_t>> mask_index_t;
+
+  bool ptr;
+  std::vector<uint32_t> spells, talents, effects;
+  std::map<std::pair<int, size_t>, field_index_t> fields;
+  std::map<int, mask_index_t> masks;
+  mutex_t mutex;
+
+  spell_query_index_t( bool p ) : ptr( p )
+  {
+    for ( const spell_data_t* spell = spell_data_t::list( ptr ); spell -> id(); spell++ )
+      spells.push_back( spell -> id() );
+    for ( const talent_data_t* talent = talent_data_t::list( ptr ); talent -> id(); talent++ )
+      talents.push_back( talent -> id() );
+    for ( const spelleffect_data_t* effect = spelleffect_data_t::list( ptr ); effect -> id(); effect++ )
+      effects.push_back( effect -> id() );
+
+    sort_unique( spells );
+    sort_unique( talents );
+    sort_unique( effects );
+  }
+
+  static spell_query_index_t& get( const sim_t* sim )
+  {
+    static spell_query_index_t live_index( false ), ptr_index( true );
+    return sim -> dbc.ptr ? ptr_index : live_index;
+  }
+
+  static void sort_unique( std::vector<uint32_t>& ids )
+  { ids.resize( range::unique( range::sort( ids ) ) - ids.begin() ); }
+
+  // Sorted ids of the table rows whose field equals the key
+  const std::vector<uint32_t>& field( table_e table, size_t offset, sdata_field_type_t type, uint64_t key )
+  {
+    static const std::vector<uint32_t> none;
+
+    AUTO_LOCK( mutex );
+
+    auto it = fields.find( std::make_pair( static_cast<int>( table ), offset ) );
+    if ( it == fields.end() )
+    {
+      it = fields.insert( std::make_pair( std::make_pair( static_cast<int>( table ), offset ), field_index_t() ) ).first;
+      build_field( it -> second, table, offset, type );
+    }
+
+    auto entry = it -> second.find( key );
+    return entry != it -> second.end() ? entry -> second : none;
+  }
+
+  // Sorted ids of the table rows with the bit of the mask set
+  const std::vector<uint32_t>& mask( mask_e m, unsigned bit )
+  {
+    static const std::vector<uint32_t> none;
+
+    AUTO_LOCK( mutex );
+
+    auto it = masks.find( m );
+    if ( it == masks.end() )
+    {
+      it = masks.insert( std::make_pair( static_cast<int>( m ), mask_index_t() ) ).first;
+      build_mask( it -> second, m );
+    }
+
+    return bit < it -> second.size() ? it -> second[ bit ] : none;
+  }
+
+  // Union of the bit indexes of every bit in bits
+  id_bitmap_t mask_any( mask_e m, uint32_t bits )
+  {
+    id_bitmap_t res;
+    for ( unsigned bit = 0; bit < 32; ++bit )
+    {
+      if ( bits & ( 1u << bit ) )
+        res |= id_bitmap_t( mask( m, bit ) );
+    }
+    return res;
+  }
+
+private:
+  void build_field( field_index_t& index, table_e table, size_t offset, sdata_field_type_t type ) const
+  {
+    switch ( table )
+    {
+      case TABLE_SPELL:
+        for ( const spell_data_t* spell = spell_data_t::list( ptr ); spell -> id(); spell++ )
+          index[ field_key( reinterpret_cast<const char*>( spell ), offset, type ) ].push_back( spell -> id() );
+        break;
+      case TABLE_TALENT:
+        for ( const talent_data_t* talent = talent_data_t::list( ptr ); talent -> id(); talent++ )
+          index[ field_key( reinterpret_cast<const char*>( talent ), offset, type ) ].push_back( talent -> id() );
+        break;
+      case TABLE_EFFECT:
+      case TABLE_SPELL_EFFECT:
+        for ( const spelleffect_data_t* effect = spelleffect_data_t::list( ptr ); effect -> id(); effect++ )
+        {
+          index[ field_key( reinterpret_cast<const char*>( effect ), offset, type ) ].push_back(
+              table == TABLE_EFFECT ? effect -> id() : effect -> spell_id() );
+        }
+        break;
+    }
+
+    for ( auto& entry : index )
+      sort_unique( entry.second );
+  }
+
+  void build_mask( mask_index_t& index, mask_e m ) const
+  {
+    index.resize( m == MASK_ATTRIBUTE ? NUM_SPELL_FLAGS * 32 : 32 );
+
+    if ( m == MASK_TALENT_CLASS )
+    {
+      for ( const talent_data_t* talent = talent_data_t::list( ptr ); talent -> id(); talent++ )
+        add_bits( index, 0, talent -> mask_class(), talent -> id() );
+    }
+    else
+    {
+      for ( const spell_data_t* spell = spell_data_t::list( ptr ); spell -> id(); spell++ )
+      {
+        switch ( m )
+        {
+          case MASK_CLASS:  add_bits( index, 0, spell -> class_mask(), spell -> id() ); break;
+          case MASK_RACE:   add_bits( index, 0, spell -> race_mask(), spell -> id() ); break;
+          case MASK_SCHOOL: add_bits( index, 0, spell -> school_mask(), spell -> id() ); break;
+          default:
+            for ( unsigned i = 0; i < NUM_SPELL_FLAGS; ++i )
+              add_bits( index, i * 32, spell -> attribute( i ), spell -> id() );
+            break;
+        }
+      }
+    }
+
+    for ( auto& ids : index )
+      sort_unique( ids );
+  }
+
+  static void add_bits( mask_index_t& index, unsigned first, uint32_t bits, uint32_t id )
+  {
+    for ( ; bits; bits &= bits - 1 )
+      index[ first + lowest_bit( bits ) ].push_back( id );
+  }
+};
+
 // Generic spell list based expression, holds intersection, union for list
 // For these expression types, you can only use two spell lists as parameters
 struct spell_list_expr_t : public spell_data_expr_t
@@ -269,24 +540,16 @@ struct spell_list_expr_t : public spell_data_expr_t
     // result_spell_list accordingly
     switch ( data_type )
     {
+      // Full tables are already sorted in the index
       case DATA_SPELL:
-      {
-        for ( const spell_data_t* spell = spell_data_t::list( sim -> dbc.ptr ); spell -> id(); spell++ )
-          result_spell_list.push_back( spell -> id() );
-        break;
-      }
+        result_spell_list = spell_query_index_t::get( sim ).spells;
+        return expression::TOK_SPELL_LIST;
       case DATA_TALENT:
-      {
-        for ( const talent_data_t* talent = talent_data_t::list( sim -> dbc.ptr ); talent -> id(); talent++ )
-          result_spell_list.push_back( talent -> id() );
-        break;
-      }
+        result_spell_list = spell_query_index_t::get( sim ).talents;
+        return expression::TOK_SPELL_LIST;
       case DATA_EFFECT:
-      {
-        for ( const spelleffect_data_t* effect = spelleffect_data_t::list( sim -> dbc.ptr ); effect -> id(); effect++ )
-          result_spell_list.push_back( effect -> id() );
-        break;
-      }
+        result_spell_list = spell_query_index_t::get( sim ).effects;
+        return expression::TOK_SPELL_LIST;
       case DATA_TALENT_SPELL:
       {
         for ( const talent_data_t* talent = talent_data_t::list( sim -> dbc.ptr ); talent -> id(); talent++ )
@@ -368,12 +631,7 @@ struct spell_list_expr_t : public spell_data_expr_t
       case DATA_ARTIFACT_SPELL:
       {
         for ( auto rank: sim -> dbc.artifact_power_ranks( 0 ) )
-        {
-          if ( range::find( result_spell_list, rank -> id_spell() ) == result_spell_list.end() )
-          {
-            result_spell_list.push_back( rank -> id_spell() );
-          }
-        }
+          result_spell_list.push_back( rank -> id_spell() );
         break;
       }
 
@@ -399,7 +657,7 @@ struct spell_list_expr_t : public spell_data_expr_t
                      other.result_tok );
     }
     else
-      range::set_intersection( result_spell_list, other.result_spell_list, std::back_inserter( res ) );
+      res = select( id_bitmap_t( other.result_spell_list ) );
 
     return res;
   }
@@ -417,7 +675,11 @@ struct spell_list_expr_t : public spell_data_expr_t
                      other.result_tok );
     }
     else
-      range::set_union( result_spell_list, other.result_spell_list, std::back_inserter( res ) );
+    {
+      id_bitmap_t set( result_spell_list );
+      set |= id_bitmap_t( other.result_spell_list );
+      res = set.ids();
+    }
 
     return res;
   }
@@ -435,10 +697,34 @@ struct spell_list_expr_t : public spell_data_expr_t
                      other.result_tok );
     }
     else
-      range::set_difference( result_spell_list, other.result_spell_list, std::back_inserter( res ) );
+      res = exclude( id_bitmap_t( other.result_spell_list ) );
 
     return res;
   }
+
+  // Ids of the result list that are in the set, in the order of the list
+  std::vector<uint32_t> select( const id_bitmap_t& set ) const
+  {
+    std::vector<uint32_t> res;
+    for ( auto id : result_spell_list )
+    {
+      if ( set.contains( id ) )
+        res.push_back( id );
+    }
+    return res;
+  }
+
+  // Ids of the result list that are not in the set
+  std::vector<uint32_t> exclude( const id_bitmap_t& set ) const
+  {
+    std::vector<uint32_t> res;
+    for ( auto id : result_spell_list )
+    {
+      if ( ! set.contains( id ) )
+        res.push_back( id );
+    }
+    return res;
+  }
 };
 
 struct sd_expr_binary_t : public spell_list_expr_t
@@ -531,6 +817,29 @@ struct spell_data_filter_expr_t : public spell_list_expr_t
     }
   }
 
+  // Integer fields are matched for equality through the field indexes. Effect
+  // fields of talent queries are compared against talent data, and are left
+  // to the scan.
+  bool indexed() const
+  {
+    if ( field_type != SD_TYPE_INT && field_type != SD_TYPE_UNSIGNED && field_type != SD_TYPE_UINT64 )
+      return false;
+
+    return ! ( effect_query && data_type == DATA_TALENT );
+  }
+
+  spell_query_index_t::table_e index_table() const
+  {
+    if ( data_type == DATA_TALENT )
+      return spell_query_index_t::TABLE_TALENT;
+    else if ( effect_query )
+      return spell_query_index_t::TABLE_SPELL_EFFECT;
+    else if ( data_type == DATA_EFFECT )
+      return spell_query_index_t::TABLE_EFFECT;
+    else
+      return spell_query_index_t::TABLE_SPELL;
+  }
+
   virtual bool compare( const char* data, const spell_data_expr_t& other, expression::token_e t ) const
   {
     switch ( field_type )
@@ -623,12 +932,9 @@ struct spell_data_filter_expr_t : public spell_list_expr_t
 
   void build_list( std::vector<uint32_t>& res, const spell_data_expr_t& other, expression::token_e t ) const
   {
+    // The result list is unique, every id is compared once
     for ( auto i = result_spell_list.begin(); i != result_spell_list.end(); ++i )
     {
-      // Don't bother comparing if this spell id is already in the result set.
-      if ( range::find( res, *i ) != res.end() )
-        continue;
-
       if ( effect_query )
       {
         const spell_data_t& spell = *sim -> dbc.spell( *i );
@@ -673,6 +979,9 @@ struct spell_data_filter_expr_t : public spell_list_expr_t
                      other.name_str.c_str(),
                      other.result_tok );
     }
+    else if ( other.result_tok == expression::TOK_NUM && indexed() )
+      res = select( id_bitmap_t( spell_query_index_t::get( sim ).field( index_table(), offset, field_type,
+                                                                       value_key( other.result_num, field_type ) ) ) );
     else
       build_list( res, other, expression::TOK_EQ );
 
@@ -820,75 +1129,29 @@ struct spell_class_expr_t : public spell_list_expr_t
 {
   spell_class_expr_t( sim_t* sim, expr_data_e type ) : spell_list_expr_t( sim, "class", type ) { }
 
-  virtual std::vector<uint32_t> operator==( const spell_data_expr_t& other ) override
+  id_bitmap_t class_set( uint32_t class_mask ) const
   {
-    std::vector<uint32_t> res;
-    uint32_t              class_mask;
+    return spell_query_index_t::get( sim ).mask_any( data_type == DATA_TALENT ? spell_query_index_t::MASK_TALENT_CLASS
+                                                                               : spell_query_index_t::MASK_CLASS,
+                                                    class_mask );
+  }
 
-    if ( other.result_tok == expression::TOK_STR )
-      class_mask = class_str_to_mask( other.result_str );
+  virtual std::vector<uint32_t> operator==( const spell_data_expr_t& other ) override
+  {
     // Other types will not be allowed, e.g. you cannot do class=list
-    else
-      return res;
-
-    for ( std::vector<uint32_t>::const_iterator i = result_spell_list.begin(); i != result_spell_list.end(); ++i )
-    {
-      if ( data_type == DATA_TALENT )
-      {
-        if ( ! sim -> dbc.talent( *i ) )
-          continue;
-
-        if ( sim -> dbc.talent( *i ) -> mask_class() & class_mask )
-          res.push_back( *i );
-      }
-      else
-      {
-        const spell_data_t* spell = sim -> dbc.spell( *i );
-
-        if ( ! spell )
-          continue;
-
-        if ( spell -> class_mask() & class_mask )
-          res.push_back( *i );
-      }
-    }
+    if ( other.result_tok != expression::TOK_STR )
+      return std::vector<uint32_t>();
 
-    return res;
+    return select( class_set( class_str_to_mask( other.result_str ) ) );
   }
 
   virtual std::vector<uint32_t> operator!=( const spell_data_expr_t& other ) override
   {
-    std::vector<uint32_t> res;
-    uint32_t              class_mask;
-
-    if ( other.result_tok == expression::TOK_STR )
-      class_mask = class_str_to_mask( other.result_str );
     // Other types will not be allowed, e.g. you cannot do class=list
-    else
-      return res;
-
-    for ( std::vector<uint32_t>::const_iterator i = result_spell_list.begin(); i != result_spell_list.end(); ++i )
-    {
-      if ( data_type == DATA_TALENT )
-      {
-        if ( ! sim -> dbc.talent( *i ) )
-          continue;
+    if ( other.result_tok != expression::TOK_STR )
+      return std::vector<uint32_t>();
 
-        if ( ( sim -> dbc.talent( *i ) -> mask_class() & class_mask ) == 0 )
-          res.push_back( *i );
-      }
-      else
-      {
-        const spell_data_t* spell = sim -> dbc.spell( *i );
-        if ( ! spell )
-          continue;
-
-        if ( ( spell -> class_mask() & class_mask ) == 0 )
-          res.push_back( *i );
-      }
-    }
-
-    return res;
+    return exclude( class_set( class_str_to_mask( other.result_str ) ) );
   }
 };
 
@@ -898,59 +1161,30 @@ struct spell_race_expr_t : public spell_list_expr_t
 
   virtual std::vector<uint32_t> operator==( const spell_data_expr_t& other ) override
   {
-    std::vector<uint32_t> res;
-    uint32_t              race_mask;
-
     // Talents are not race specific
     if ( data_type == DATA_TALENT )
-      return res;
+      return std::vector<uint32_t>();
 
-    if ( other.result_tok == expression::TOK_STR )
-      race_mask = race_str_to_mask( other.result_str );
     // Other types will not be allowed, e.g. you cannot do race=list
-    else
-      return res;
-
-    for ( std::vector<uint32_t>::const_iterator i = result_spell_list.begin(); i != result_spell_list.end(); ++i )
-    {
-      const spell_data_t* spell = sim -> dbc.spell( *i );
+    if ( other.result_tok != expression::TOK_STR )
+      return std::vector<uint32_t>();
 
-      if ( ! spell )
-        continue;
-
-      if ( spell -> race_mask() & race_mask )
-        res.push_back( *i );
-    }
-
-    return res;
+    return select( spell_query_index_t::get( sim ).mask_any( spell_query_index_t::MASK_RACE,
+                                                             race_str_to_mask( other.result_str ) ) );
   }
 
   virtual std::vector<uint32_t> operator!=( const spell_data_expr_t& other ) override
   {
-    std::vector<uint32_t> res;
-    uint32_t              class_mask;
-
     // Talents are not race specific
     if ( data_type == DATA_TALENT )
-      return res;
+      return std::vector<uint32_t>();
 
-    if ( other.result_tok == expression::TOK_STR )
-      class_mask = race_str_to_mask( other.result_str );
-    // Other types will not be allowed, e.g. you cannot do class=list
-    else
-      return res;
-
-    for ( std::vector<uint32_t>::const_iterator i = result_spell_list.begin(); i != result_spell_list.end(); ++i )
-    {
-      const spell_data_t* spell = sim -> dbc.spell( *i );
-      if ( ! spell )
-        continue;
-
-      if ( ( spell -> class_mask() & class_mask ) == 0 )
-        res.push_back( *i );
-    }
+    // Other types will not be allowed, e.g. you cannot do race=list
+    if ( other.result_tok != expression::TOK_STR )
+      return std::vector<uint32_t>();
 
-    return res;
+    return exclude( spell_query_index_t::get( sim ).mask_any( spell_query_index_t::MASK_RACE,
+                                                              race_str_to_mask( other.result_str ) ) );
   }
 };
 
@@ -960,33 +1194,19 @@ struct spell_attribute_expr_t : public spell_list_expr_t
 
   virtual std::vector<uint32_t> operator==( const spell_data_expr_t& other ) override
   {
-    std::vector<uint32_t> res;
-
     // Only for spells
     if ( data_type == DATA_EFFECT || data_type == DATA_TALENT )
-      return res;
+      return std::vector<uint32_t>();
 
     // Numbered attributes only
     if ( other.result_tok != expression::TOK_NUM )
-      return res;
-
-    uint32_t attridx = ( unsigned ) other.result_num / ( sizeof( unsigned ) * 8 );
-    uint32_t flagidx = ( unsigned ) other.result_num % ( sizeof( unsigned ) * 8 );
-
-    assert( attridx < NUM_SPELL_FLAGS && flagidx < 32 );
-
-    for ( std::vector<uint32_t>::const_iterator i = result_spell_list.begin(); i != result_spell_list.end(); ++i )
-    {
-      const spell_data_t* spell = sim -> dbc.spell( *i );
+      return std::vector<uint32_t>();
 
-      if ( ! spell )
-        continue;
+    unsigned attribute = static_cast<unsigned>( other.result_num );
 
-      if ( spell -> attribute( attridx ) & ( 1 << flagidx ) )
-        res.push_back( *i );
-    }
+    assert( attribute < NUM_SPELL_FLAGS * 32 );
 
-    return res;
+    return select( id_bitmap_t( spell_query_index_t::get( sim ).mask( spell_query_index_t::MASK_ATTRIBUTE, attribute ) ) );
   }
 };
 
@@ -994,54 +1214,45 @@ struct spell_school_expr_t : public spell_list_expr_t
 {
   spell_school_expr_t( sim_t* sim, expr_data_e type ) : spell_list_expr_t( sim, "school", type ) { }
 
+  // Spells of every school in the mask
   virtual std::vector<uint32_t> operator==( const spell_data_expr_t& other ) override
   {
-    std::vector<uint32_t> res;
-    uint32_t              school_mask;
-
-    if ( other.result_tok == expression::TOK_STR )
-      school_mask = school_str_to_mask( other.result_str );
     // Other types will not be allowed, e.g. you cannot do class=list
-    else
-      return res;
+    if ( other.result_tok != expression::TOK_STR )
+      return std::vector<uint32_t>();
 
-    for ( std::vector<uint32_t>::const_iterator i = result_spell_list.begin(); i != result_spell_list.end(); ++i )
-    {
-      const spell_data_t* spell = sim -> dbc.spell( *i );
+    uint32_t school_mask = school_str_to_mask( other.result_str );
+    if ( school_mask == 0 )
+      return result_spell_list;
 
-      if ( ! spell )
+    spell_query_index_t& index = spell_query_index_t::get( sim );
+    id_bitmap_t set;
+    bool first = true;
+    for ( unsigned bit = 0; bit < 32; ++bit )
+    {
+      if ( ! ( school_mask & ( 1u << bit ) ) )
         continue;
 
-      if ( ( spell -> school_mask() & school_mask ) == school_mask )
-        res.push_back( *i );
+      id_bitmap_t school( index.mask( spell_query_index_t::MASK_SCHOOL, bit ) );
+      if ( first )
+        set = school;
+      else
+        set &= school;
+      first = false;
     }
 
-    return res;
+    return select( set );
   }
 
+  // Spells of none of the schools in the mask
   virtual std::vector<uint32_t> operator!=( const spell_data_expr_t& other ) override
   {
-    std::vector<uint32_t> res;
-    uint32_t              school_mask;
-
-    if ( other.result_tok == expression::TOK_STR )
-      school_mask = school_str_to_mask( other.result_str );
     // Other types will not be allowed, e.g. you cannot do school=list
-    else
-      return res;
+    if ( other.result_tok != expression::TOK_STR )
+      return std::vector<uint32_t>();
 
-    for ( std::vector<uint32_t>::const_iterator i = result_spell_list.begin(); i != result_spell_list.end(); ++i )
-    {
-      const spell_data_t* spell = sim -> dbc.spell( *i );
-
-      if ( ! spell )
-        continue;
-
-      if ( ( spell -> school_mask() & school_mask ) == 0 )
-        res.push_back( *i );
-    }
-
-    return res;
+    return exclude( spell_query_index_t::get( sim ).mask_any( spell_query_index_t::MASK_SCHOOL,
+                                                              school_str_to_mask( other.result_str ) ) );
   }
 };
 
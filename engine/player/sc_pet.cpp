@@ -27,6 +27,9 @@ void pet_t::init_pet_t_()
   expiration = nullptr;
   duration = timespan_t::zero();
   affects_wod_legendary_ring = true;
+  pool = nullptr;
+  pool_spawned = false;
+  pool_dirty = true;
 
   owner -> pet_list.push_back( this );
 
@@ -142,9 +145,42 @@ void pet_t::init_target()
 
 void pet_t::reset()
 {
+  // Pool members that have not been spawned since the last reset are still in the reset state
+  if ( pool && ! pool_dirty )
+    return;
+
   base_t::reset();
 
   expiration = nullptr;
+  pool_dirty = false;
+}
+
+// pet_t::arise =============================================================
+
+void pet_t::arise()
+{
+  bool was_sleeping = is_sleeping();
+
+  base_t::arise();
+
+  if ( pool && was_sleeping && ! is_sleeping() )
+  {
+    pool_spawned = true;
+    pool_dirty = true;
+  }
+}
+
+// pet_t::merge =============================================================
+
+void pet_t::merge( player_t& other )
+{
+  base_t::merge( other );
+
+  pet_t& other_pet = static_cast<pet_t&>( other );
+  if ( pool && other_pet.pool )
+  {
+    pool_spawned = pool_spawned || other_pet.pool_spawned;
+  }
 }
 
 // pet_t::summon ============================================================
@@ -601,15 +601,17 @@ player_t::player_t( sim_t*             s,
   use_apl( "" ),
   // Actions
   use_default_action_list( 0 ),
+  dot_ticks( this ),
   precombat_action_list( 0 ), active_action_list( 0 ), active_off_gcd_list( 0 ), restore_action_list( 0 ),
   no_action_list_provided(),
   // Reporting
   quiet( false ),
+  minimal_data_collection( false ),
   report_extension( new player_report_extension_t() ),
   iteration_fight_length( timespan_t::zero() ), arise_time( timespan_t::min() ),
   iteration_waiting_time( timespan_t::zero() ), iteration_pooling_time( timespan_t::zero() ),
   iteration_executed_foreground_actions( 0 ),
-  rps_gain( 0 ), rps_loss( 0 ),
+  rps_gain( 0 ), rps_loss( 0 ), init_time( 0 ),
 
   tmi_window( 6.0 ),
   collected_data( name_str, *sim ),
@@ -643,6 +645,8 @@ player_t::player_t( sim_t*             s,
   racials( racials_t() ),
   passive_values( passives_t() ),
   active_during_iteration( false ),
+  sparse_timeline_active( false ),
+  sparse_timeline_event( nullptr ),
   _mastery( spelleffect_data_t::nil() ),
   cache( this ),
   regen_type( REGEN_STATIC ),
@@ -700,6 +704,7 @@ player_t::player_t( sim_t*             s,
   {
     cache.active = sim -> stat_cache != 0;
   }
+  init_cache_invalidation( false );
   if ( is_pet() ) current.skill = 1.0;
 
   resources.infinite_resource[ RESOURCE_HEALTH ] = true;
@@ -1477,7 +1482,7 @@ void player_t::init_resources( bool force )
   resources.current = resources.max = resources.initial;
 
   // Only collect pet resource timelines if they get reported separately
-  if ( ! is_pet() || sim -> report_pets_separately )
+  if ( ( ! is_pet() || sim -> report_pets_separately ) && ! minimal_data_collection )
   {
     if ( collected_data.resource_timelines.size() == 0 )
     {
@@ -2066,7 +2071,7 @@ void player_t::init_stats()
       stat_timelines.push_back( s );
     }
   }
-  if ( ! is_pet() || sim -> report_pets_separately )
+  if ( ( ! is_pet() || sim -> report_pets_separately ) && ! minimal_data_collection )
   {
     if ( collected_data.stat_timelines.size() == 0 )
     {
@@ -2373,8 +2378,9 @@ bool player_t::create_actions()
   }
 
   int capacity = std::max( 1200, static_cast<int>( sim -> max_time.total_seconds() / 2.0 ) );
-  collected_data.action_sequence.reserve( capacity );
+  size_t n_sequences = std::max( sim -> sequence_iterations.size(), size_t( 1 ) );
   collected_data.action_sequence.clear();
+  collected_data.action_sequence.reserve( capacity * n_sequences );
 
   return true;
 }
@@ -2514,7 +2520,7 @@ void player_t::init_assessors()
     proc_types pt = state -> proc_type();
     proc_types2 pt2 = state -> impact_proc_type2();
     if ( pt != PROC1_INVALID && pt2 != PROC2_INVALID )
-      action_callback_t::trigger( callbacks.procs[ pt ][ pt2 ], state -> action, state );
+      callbacks.trigger( pt, pt2, state -> action, state );
 
     return assessor::CONTINUE;
   } );
@@ -2553,6 +2559,7 @@ bool player_t::init_finished()
   range::for_each( cooldown_list, [ this ]( cooldown_t* c ) {
     if ( c -> hasted )
     {
+      c -> dynamic_index = as<int>( dynamic_cooldown_list.size() );
       dynamic_cooldown_list.push_back( c );
     }
   } );
@@ -3655,77 +3662,91 @@ double player_t::composite_mastery_value() const
   return composite_mastery() * mastery_coefficient();
 }
 
+// player_t::init_cache_invalidation ========================================
+
+/* Build the transitive invalidation mask of each cache entry from the base invalidation chains.
+ * Some chains depend on the current stat conversions of the player, which are only known after
+ * initialization. Until then, all conditional chains are included.
+ */
+void player_t::init_cache_invalidation( bool exact )
+{
+  std::array<player_stat_cache_t::mask_t, CACHE_MAX> links;
+  auto link = [ &links ]( cache_e from, cache_e to ) { links[ from ].set( to ); };
+
+  // Special linked invalidations
+  if ( ! exact || current.attack_power_per_strength > 0 )
+    link( CACHE_STRENGTH, CACHE_ATTACK_POWER );
+  if ( ! exact || current.parry_per_strength > 0 )
+    link( CACHE_STRENGTH, CACHE_PARRY );
+  if ( ! exact || current.attack_power_per_agility > 0 )
+    link( CACHE_AGILITY, CACHE_ATTACK_POWER );
+  if ( ! exact || current.dodge_per_agility > 0 )
+    link( CACHE_AGILITY, CACHE_DODGE );
+  if ( ! exact || current.spell_power_per_intellect > 0 )
+    link( CACHE_INTELLECT, CACHE_SPELL_POWER );
+  link( CACHE_ATTACK_HASTE, CACHE_ATTACK_SPEED );
+  link( CACHE_SPELL_HASTE, CACHE_SPELL_SPEED );
+  link( CACHE_BONUS_ARMOR, CACHE_ARMOR );
+
+  // Combined caches
+  link( CACHE_EXP, CACHE_ATTACK_EXP );
+  link( CACHE_EXP, CACHE_SPELL_HIT );
+  link( CACHE_HIT, CACHE_ATTACK_HIT );
+  link( CACHE_HIT, CACHE_SPELL_HIT );
+  link( CACHE_CRIT_CHANCE, CACHE_ATTACK_CRIT_CHANCE );
+  link( CACHE_CRIT_CHANCE, CACHE_SPELL_CRIT_CHANCE );
+  link( CACHE_HASTE, CACHE_ATTACK_HASTE );
+  link( CACHE_HASTE, CACHE_SPELL_HASTE );
+  link( CACHE_SPEED, CACHE_ATTACK_SPEED );
+  link( CACHE_SPEED, CACHE_SPELL_SPEED );
+  link( CACHE_VERSATILITY, CACHE_DAMAGE_VERSATILITY );
+  link( CACHE_VERSATILITY, CACHE_HEAL_VERSATILITY );
+  link( CACHE_VERSATILITY, CACHE_MITIGATION_VERSATILITY );
+
+  for ( size_t c = 0; c < cache_invalidation_mask.size(); ++c )
+  {
+    player_stat_cache_t::mask_t& mask = cache_invalidation_mask[ c ];
+    mask.reset();
+    mask.set( c );
+
+    player_stat_cache_t::mask_t prev;
+    while ( prev != mask )
+    {
+      prev = mask;
+      for ( size_t i = 0; i < links.size(); ++i )
+      {
+        if ( prev.test( i ) )
+          mask |= links[ i ];
+      }
+    }
+  }
+}
+
 #if defined(SC_USE_STAT_CACHE)
 
 // player_t::invalidate_cache ===============================================
 
 void player_t::invalidate_cache( cache_e c )
 {
+  if ( sparse_timeline_active && ( cache_invalidation_mask[ c ] & sparse_timeline_caches ).any() )
+    sparse_timeline_schedule_sync();
+
   if ( ! cache.active ) return;
 
   if ( sim -> debug ) sim -> out_debug.printf( "%s invalidates %s", name(), util::cache_type_string( c ) );
 
-  // Special linked invalidations
-  switch ( c )
-  {
-    case CACHE_STRENGTH:
-      if ( current.attack_power_per_strength > 0 )
-        invalidate_cache( CACHE_ATTACK_POWER );
-      if ( current.parry_per_strength > 0 )
-        invalidate_cache( CACHE_PARRY );
-      break;
-    case CACHE_AGILITY:
-      if ( current.attack_power_per_agility > 0 )
-        invalidate_cache( CACHE_ATTACK_POWER );
-      if ( current.dodge_per_agility > 0 )
-        invalidate_cache( CACHE_DODGE );
-      break;
-    case CACHE_INTELLECT:
-      if ( current.spell_power_per_intellect > 0 )
-        invalidate_cache( CACHE_SPELL_POWER );
-      break;
-    case CACHE_ATTACK_HASTE:
-      invalidate_cache( CACHE_ATTACK_SPEED );
-      break;
-    case CACHE_SPELL_HASTE:
-      invalidate_cache( CACHE_SPELL_SPEED );
-      break;
-    case CACHE_BONUS_ARMOR:
-      invalidate_cache( CACHE_ARMOR );
-    default: break;
-  }
+  const player_stat_cache_t::mask_t& mask = cache_invalidation_mask[ c ];
+  cache.invalidate( mask );
 
-  // Normal invalidation of the corresponding Cache
-  switch ( c )
+  player_stat_cache_t::mask_t notify = mask & cache_invalidation_notify;
+  notify.reset( c );
+  if ( notify.none() )
+    return;
+
+  for ( size_t i = 0; i < notify.size(); ++i )
   {
-    case CACHE_EXP:
-      invalidate_cache( CACHE_ATTACK_EXP );
-      invalidate_cache( CACHE_SPELL_HIT  );
-      break;
-    case CACHE_HIT:
-      invalidate_cache( CACHE_ATTACK_HIT );
-      invalidate_cache( CACHE_SPELL_HIT  );
-      break;
-    case CACHE_CRIT_CHANCE:
-      invalidate_cache( CACHE_ATTACK_CRIT_CHANCE );
-      invalidate_cache( CACHE_SPELL_CRIT_CHANCE  );
-      break;
-    case CACHE_HASTE:
-      invalidate_cache( CACHE_ATTACK_HASTE );
-      invalidate_cache( CACHE_SPELL_HASTE  );
-      break;
-    case CACHE_SPEED:
-      invalidate_cache( CACHE_ATTACK_SPEED );
-      invalidate_cache( CACHE_SPELL_SPEED  );
-      break;
-    case CACHE_VERSATILITY:
-      invalidate_cache( CACHE_DAMAGE_VERSATILITY );
-      invalidate_cache( CACHE_HEAL_VERSATILITY );
-      invalidate_cache( CACHE_MITIGATION_VERSATILITY );
-      break;
-    default:
-      cache.invalidate( c );
-      break;
+    if ( notify.test( i ) )
+      invalidate_cache( static_cast<cache_e>( i ) );
   }
 }
 
@@ -3733,46 +3754,38 @@ void player_t::invalidate_cache( cache_e c )
 
 void player_t::sequence_add_wait( const timespan_t& amount, const timespan_t& ts )
 {
-  // Collect iteration#1 data, for log/debug/iterations==1 simulation iteration#0 data
-  if ( ( sim -> iterations <= 1 && sim -> current_iteration == 0 ) ||
-       ( sim -> iterations > 1 && sim -> current_iteration == 1 ) )
+  if ( ! sim -> record_sequence || ! in_combat )
+    return;
+
+  action_sequence_t& seq = collected_data.action_sequence;
+  if ( seq.current_size() <= sim -> expected_max_time() * 2.0 + 3.0 )
   {
-    if ( collected_data.action_sequence.size() <= sim -> expected_max_time() * 2.0 + 3.0 )
-    {
-      if ( in_combat )
-      {
-        if ( collected_data.action_sequence.size() && collected_data.action_sequence.back() -> wait_time > timespan_t::zero() )
-          collected_data.action_sequence.back() -> wait_time += amount;
-        else
-          collected_data.action_sequence.push_back( new player_collected_data_t::action_sequence_data_t( ts, amount, this ) );
-      }
-    }
+    if ( seq.current_size() && seq.entries.back().wait_time > timespan_t::zero() )
+      seq.entries.back().wait_time += amount;
     else
-    {
-      assert( false && "Collected too much action sequence data."
-      "This means there is a serious overflow of executed actions in the first iteration, which should be fixed." );
-    }
+      seq.add( sim -> current_iteration, nullptr, nullptr, ts, amount, this );
+  }
+  else
+  {
+    assert( false && "Collected too much action sequence data."
+    "This means there is a serious overflow of executed actions in the first iteration, which should be fixed." );
   }
 }
 
 void player_t::sequence_add( const action_t* a, const player_t* target, const timespan_t& ts )
 {
-  // Collect iteration#1 data, for log/debug/iterations==1 simulation iteration#0 data
-  if ( ( a -> sim -> iterations <= 1 && a -> sim -> current_iteration == 0 ) ||
-       ( a -> sim -> iterations > 1 && a -> sim -> current_iteration == 1 ) )
+  if ( ! sim -> record_sequence )
+    return;
+
+  action_sequence_t& seq = collected_data.action_sequence;
+  if ( seq.current_size() <= sim -> expected_max_time() * 2.0 + 3.0 )
   {
-    if ( collected_data.action_sequence.size() <= sim -> expected_max_time() * 2.0 + 3.0 )
-    {
-      if ( in_combat )
-        collected_data.action_sequence.push_back( new player_collected_data_t::action_sequence_data_t( a, target, ts, this ) );
-      else
-        collected_data.action_sequence_precombat.push_back( new player_collected_data_t::action_sequence_data_t( a, target, ts, this ) );
-    }
-    else
-    {
-      assert( false && "Collected too much action sequence data."
-      "This means there is a serious overflow of executed actions in the first iteration, which should be fixed." );
-    }
+    seq.add( sim -> current_iteration, a, target, ts, timespan_t::zero(), this );
+  }
+  else
+  {
+    assert( false && "Collected too much action sequence data."
+    "This means there is a serious overflow of executed actions in the first iteration, which should be fixed." );
   }
 }
 
@@ -3922,6 +3935,9 @@ void player_t::datacollection_begin()
     collected_data.health_changes_tmi.timeline_normalized.clear();
   }
 
+  if ( minimal_data_collection )
+    return;
+
   range::for_each( buff_list, std::mem_fn(&buff_t::datacollection_begin ) );
   range::for_each( stats_list, std::mem_fn(&stats_t::datacollection_begin ) );
   range::for_each( uptime_list, std::mem_fn(&uptime_t::datacollection_begin ) );
@@ -3945,6 +3961,8 @@ void player_t::datacollection_end()
   for ( size_t i = 0; i < pet_list.size(); ++i )
     pet_list[ i ] -> datacollection_end();
 
+  sparse_timeline_end();
+
   if ( arise_time >= timespan_t::zero() )
   {
     // If we collect data while the player is still alive, capture active time up to now
@@ -3953,6 +3971,12 @@ void player_t::datacollection_end()
     arise_time = sim -> current_time();
   }
 
+  if ( minimal_data_collection )
+  {
+    collected_data.collect_minimal_data( *this );
+    return;
+  }
+
   for ( size_t i = 0; i < stats_list.size(); ++i )
     stats_list[ i ] -> datacollection_end();
 
@@ -4110,6 +4134,12 @@ void merge( player_t& left, player_t& right )
 
 void player_t::merge( player_t& other )
 {
+  if ( minimal_data_collection )
+  {
+    collected_data.merge_minimal( other.collected_data );
+    return;
+  }
+
   collected_data.merge( other.collected_data );
 
   for ( resource_e i = RESOURCE_NONE; i < RESOURCE_MAX; ++i )
@@ -4243,6 +4273,8 @@ void player_t::reset()
   // Reset current stats to initial stats
   current = initial;
 
+  init_cache_invalidation();
+
   current.sleeping = true;
 
   change_position( initial.position );
@@ -4287,8 +4319,7 @@ void player_t::reset()
   off_hand_weapon.buff_value = 0;
   off_hand_weapon.bonus_dmg  = 0;
 
-  x_position = default_x_position;
-  y_position = default_y_position;
+  set_position( default_x_position, default_y_position );
 
   callbacks.reset();
 
@@ -4299,6 +4330,7 @@ void player_t::reset()
 
   for ( size_t i = 0; i < cooldown_list.size(); ++i )
     cooldown_list[ i ] -> reset_init();
+  running_dynamic_cooldowns.clear();
 
   for ( size_t i = 0; i < dot_list.size(); ++i )
     dot_list[ i ] -> reset();
@@ -4534,6 +4566,8 @@ void player_t::arise()
 
   active_during_iteration = true;
 
+  sparse_timeline_begin();
+
   for ( auto callback: callbacks.all_callbacks ) {
     dbc_proc_callback_t* cb = debug_cast<dbc_proc_callback_t*>( callback );
 
@@ -4571,6 +4605,8 @@ void player_t::demise()
    * need to be associated with eg. resolve Diminishing Return list.
    */
 
+  sparse_timeline_end();
+
   assert( arise_time >= timespan_t::zero() );
   iteration_fight_length += sim -> current_time() - arise_time;
   // Arise time has to be set to default value before actions are canceled.
@@ -4817,31 +4853,188 @@ void player_t::collect_resource_timeline_information()
   }
 
   for (auto & elem : collected_data.stat_timelines)
+  {
+    elem.timeline.add( sim -> current_time(), stat_timeline_value( elem.type ) );
+  }
+}
+
+// player_t::stat_timeline_value ============================================
+
+double player_t::stat_timeline_value( stat_e stat ) const
+{
+  switch ( stat )
+  {
+    case STAT_STRENGTH:
+      return cache.strength();
+    case STAT_AGILITY:
+      return cache.agility();
+    case STAT_INTELLECT:
+      return cache.intellect();
+    case STAT_SPELL_POWER:
+      return cache.spell_power( SCHOOL_NONE );
+    case STAT_ATTACK_POWER:
+      return cache.attack_power();
+    default:
+      return 0;
+  }
+}
+
+namespace {
+
+// Records sparse stat timelines once all the stat changes of the current timestamp have been
+// applied. Invalidation happens before the buff or stat value is actually changed, so the new
+// values cannot be read at invalidation time.
+struct sparse_timeline_sync_event_t : public player_event_t
+{
+  sparse_timeline_sync_event_t( player_t& p ) :
+    player_event_t( p, timespan_t::zero() )
+  { }
+
+  virtual const char* name() const override
+  { return "sparse_timeline_sync"; }
+
+  virtual void execute() override
+  {
+    p() -> sparse_timeline_event = nullptr;
+    p() -> sparse_timeline_sync();
+  }
+};
+
+} // unnamed namespace
+
+// player_t::sparse_timeline_begin ==========================================
+
+/* With sparse timeline collection, the resource and stat timelines of an actor hold value changes
+ * during iterations instead of periodic samples. Changes are recorded in the first one second bin
+ * they would have been sampled in, and the merged timelines are turned back into per-second values
+ * in player_collected_data_t::analyze().
+ */
+void player_t::sparse_timeline_begin()
+{
+  if ( ! sim -> sparse_timelines )
+    return;
+
+  // Collect the same actors and iterations as the periodic resource_timeline_collect_event_t
+  if ( sim -> iterations > 1 && sim -> current_iteration == 0 )
+    return;
+
+  if ( ! is_enemy() && primary_resource() == RESOURCE_NONE )
+    return;
+
+  if ( sim -> single_actor_batch && ! is_enemy() &&
+       sim -> player_no_pet_list[ sim -> current_index ] != ( is_pet() ? cast_pet() -> owner : this ) )
+    return;
+
+  sparse_timeline_active = true;
+  sparse_timeline_event = nullptr;
+
+  // Only invalidations of these cache entries can change a stat timeline value
+  sparse_timeline_caches.reset();
+  for ( const auto& elem : collected_data.stat_timelines )
   {
     switch ( elem.type )
     {
-      case STAT_STRENGTH:
-        elem.timeline.add( sim -> current_time(), cache.strength() );
-        break;
-      case STAT_AGILITY:
-        elem.timeline.add( sim -> current_time(), cache.agility() );
-        break;
-      case STAT_INTELLECT:
-        elem.timeline.add( sim -> current_time(), cache.intellect() );
-        break;
-      case STAT_SPELL_POWER:
-        elem.timeline.add( sim -> current_time(), cache.spell_power( SCHOOL_NONE ) );
-        break;
-      case STAT_ATTACK_POWER:
-        elem.timeline.add( sim -> current_time(), cache.attack_power() );
-        break;
-      default:
-        elem.timeline.add( sim -> current_time(), 0 );
-        break;
+      case STAT_STRENGTH:     sparse_timeline_caches.set( CACHE_STRENGTH ); break;
+      case STAT_AGILITY:      sparse_timeline_caches.set( CACHE_AGILITY ); break;
+      case STAT_INTELLECT:    sparse_timeline_caches.set( CACHE_INTELLECT ); break;
+      case STAT_SPELL_POWER:  sparse_timeline_caches.set( CACHE_SPELL_POWER ); break;
+      case STAT_ATTACK_POWER: sparse_timeline_caches.set( CACHE_ATTACK_POWER ); break;
+      default: break;
+    }
+  }
+
+  for ( auto& elem : collected_data.resource_timelines )
+  {
+    elem.sparse_value = resources.current[ elem.type ];
+    elem.timeline.add_delta( sim -> current_time(), elem.sparse_value );
+  }
+
+  for ( auto& elem : collected_data.stat_timelines )
+  {
+    elem.sparse_value = stat_timeline_value( elem.type );
+    elem.timeline.add_delta( sim -> current_time(), elem.sparse_value );
+  }
+}
+
+// player_t::sparse_timeline_end ============================================
+
+void player_t::sparse_timeline_end()
+{
+  if ( ! sparse_timeline_active )
+    return;
+
+  if ( sparse_timeline_event )
+  {
+    event_t::cancel( sparse_timeline_event );
+  }
+
+  sparse_timeline_sync();
+
+  for ( auto& elem : collected_data.resource_timelines )
+  {
+    elem.timeline.end_delta( sim -> current_time(), elem.sparse_value );
+  }
+
+  for ( auto& elem : collected_data.stat_timelines )
+  {
+    elem.timeline.end_delta( sim -> current_time(), elem.sparse_value );
+  }
+
+  sparse_timeline_active = false;
+}
+
+// player_t::sparse_timeline_sync ===========================================
+
+void player_t::sparse_timeline_sync()
+{
+  if ( ! sparse_timeline_active )
+    return;
+
+  for ( auto& elem : collected_data.resource_timelines )
+  {
+    sparse_timeline_resource( elem.type );
+  }
+
+  for ( auto& elem : collected_data.stat_timelines )
+  {
+    double value = stat_timeline_value( elem.type );
+    if ( value != elem.sparse_value )
+    {
+      elem.timeline.add_delta( sim -> current_time(), value - elem.sparse_value );
+      elem.sparse_value = value;
     }
   }
 }
 
+// player_t::sparse_timeline_schedule_sync ==================================
+
+void player_t::sparse_timeline_schedule_sync()
+{
+  if ( ! sparse_timeline_active || sparse_timeline_event )
+    return;
+
+  sparse_timeline_event = make_event<sparse_timeline_sync_event_t>( *sim, *this );
+}
+
+// player_t::sparse_timeline_resource =======================================
+
+void player_t::sparse_timeline_resource( resource_e resource_type )
+{
+  for ( auto& elem : collected_data.resource_timelines )
+  {
+    if ( elem.type != resource_type )
+      continue;
+
+    double value = resources.current[ resource_type ];
+    if ( value != elem.sparse_value )
+    {
+      elem.timeline.add_delta( sim -> current_time(), value - elem.sparse_value );
+      elem.sparse_value = value;
+    }
+    break;
+  }
+}
+
 // player_t::resource_loss ==================================================
 
 double player_t::resource_loss( resource_e resource_type,
@@ -4883,6 +5076,11 @@ double player_t::resource_loss( resource_e resource_type,
     last_cast = sim -> current_time();
   }
 
+  if ( sparse_timeline_active )
+  {
+    sparse_timeline_resource( resource_type );
+  }
+
   if ( sim -> debug )
     sim -> out_debug.printf( "Player %s loses %.2f (%.2f) %s. pct=%.2f%% (%.0f/%.0f)",
                    name(),
@@ -4922,6 +5120,11 @@ double player_t::resource_gain( resource_e resource_type,
     source -> add( resource_type, actual_amount, amount - actual_amount );
   }
 
+  if ( sparse_timeline_active && actual_amount > 0.0 )
+  {
+    sparse_timeline_resource( resource_type );
+  }
+
   if ( sim -> log )
   {
     sim -> out_log.printf( "%s gains %.2f (%.2f) %s from %s (%.2f/%.2f)",
@@ -4960,6 +5163,9 @@ bool player_t::resource_available( resource_e resource_type,
 
 void player_t::recalculate_resource_max( resource_e resource_type )
 {
+  // Class modules may adjust the current value after the base recalculation
+  sparse_timeline_schedule_sync();
+
   resources.max[ resource_type ]  = resources.base[ resource_type ];
   resources.max[ resource_type ] *= resources.base_multiplier[ resource_type ];
   resources.max[ resource_type ] += total_gear.resource[ resource_type ];
@@ -5750,7 +5956,7 @@ void player_t::do_damage( action_state_t* incoming_state )
     // On damage/heal in. Proc flags are arranged as such that the "incoming"
     // version of the primary proc flag is always follows the outgoing version.
     if ( pt != PROC1_INVALID && pt2 != PROC2_INVALID )
-      action_callback_t::trigger( callbacks.procs[pt + 1][pt2], incoming_state -> action, incoming_state );
+      callbacks.trigger( static_cast<proc_types>( pt + 1 ), pt2, incoming_state -> action, incoming_state );
   }
 
   // Check if target is dying
@@ -5907,19 +6113,68 @@ bool player_t::recent_cast()
   return ( last_cast > timespan_t::zero() ) && ( ( last_cast + timespan_t::from_seconds( 5.0 ) ) > sim -> current_time() );
 }
 
+template <typename T>
+T* find_vector_member( const std::vector<T*>& list, const std::string& name )
+{
+  for (auto t : list)
+  {
+
+    if ( t -> name_str == name )
+      return t;
+  }
+  return nullptr;
+}
+
+// Find an object of a registry through its symbol index
+template <typename T, typename Predicate>
+T* find_indexed( const player_t& p, const symbol_index_t<T>& index, const std::vector<T*>& list,
+                 const std::string& name, Predicate pred )
+{
+  bool linear;
+  T* t = index.find( p.symbols, list, name, pred, &linear );
+
+  // Objects added to the registry without going through the player are not indexed
+  if ( linear && p.sim -> debug )
+  {
+    p.sim -> out_debug.printf( "%s registry lookup of '%s' is linear, %u of %u objects are indexed",
+                               p.name(), name.c_str(), static_cast<unsigned>( index.size() ),
+                               static_cast<unsigned>( list.size() ) );
+  }
+
+  return t;
+}
+
+template <typename T>
+T* find_indexed( const player_t& p, const symbol_index_t<T>& index, const std::vector<T*>& list,
+                 const std::string& name )
+{
+  return find_indexed( p, index, list, name, []( const T* ) { return true; } );
+}
+
+// Register a new object of a registry
+template <typename T>
+T* add_indexed( player_t& p, symbol_index_t<T>& index, std::vector<T*>& list, T* t )
+{
+  list.push_back( t );
+  index.add( p.symbols.intern( t -> name_str ), t );
+  return t;
+}
+
 // player_t::find_dot =======================================================
 
 dot_t* player_t::find_dot( const std::string& name,
                            player_t* source ) const
 {
-  for ( size_t i = 0; i < dot_list.size(); ++i )
-  {
-    dot_t* d = dot_list[ i ];
-    if ( d -> source == source &&
-         d -> name_str == name )
-      return d;
-  }
-  return 0;
+  return find_indexed( *this, dot_index, dot_list, name, [ source ]( const dot_t* d ) {
+    return d -> source == source; } );
+}
+
+// player_t::find_buff ======================================================
+
+buff_t* player_t::find_buff( const std::string& name, player_t* source ) const
+{
+  return find_indexed( *this, buff_index, buff_list, name, [ source ]( const buff_t* b ) {
+    return ! source || source == b -> source; } );
 }
 
 // player_t::clear_action_priority_lists() ==================================
@@ -5952,17 +6207,6 @@ void player_t::copy_action_priority_list( const std::string& old_list, const std
   }
 }
 
-template <typename T>
-T* find_vector_member( const std::vector<T*>& list, const std::string& name )
-{
-  for (auto t : list)
-  {
-
-    if ( t -> name_str == name )
-      return t;
-  }
-  return nullptr;
-}
 
 // player_t::find_action_priority_list( const std::string& name ) ===========
 
@@ -5973,25 +6217,25 @@ pet_t* player_t::find_pet( const std::string& name ) const
 { return find_vector_member( pet_list, name ); }
 
 stats_t* player_t::find_stats( const std::string& name ) const
-{ return find_vector_member( stats_list, name ); }
+{ return find_indexed( *this, stats_index, stats_list, name ); }
 
 gain_t* player_t::find_gain ( const std::string& name ) const
-{ return find_vector_member( gain_list, name ); }
+{ return find_indexed( *this, gain_index, gain_list, name ); }
 
 proc_t* player_t::find_proc ( const std::string& name ) const
-{ return find_vector_member( proc_list, name ); }
+{ return find_indexed( *this, proc_index, proc_list, name ); }
 
 luxurious_sample_data_t* player_t::find_sample_data( const std::string& name ) const
-{ return find_vector_member( sample_data_list, name ); }
+{ return find_indexed( *this, sample_data_index, sample_data_list, name ); }
 
 benefit_t* player_t::find_benefit ( const std::string& name ) const
-{ return find_vector_member( benefit_list, name ); }
+{ return find_indexed( *this, benefit_index, benefit_list, name ); }
 
 uptime_t* player_t::find_uptime ( const std::string& name ) const
-{ return find_vector_member( uptime_list, name ); }
+{ return find_indexed( *this, uptime_index, uptime_list, name ); }
 
 cooldown_t* player_t::find_cooldown( const std::string& name ) const
-{ return find_vector_member( cooldown_list, name ); }
+{ return find_indexed( *this, cooldown_index, cooldown_list, name ); }
 
 action_t* player_t::find_action( const std::string& name ) const
 { return find_vector_member( action_list, name ); }
@@ -6006,7 +6250,7 @@ cooldown_t* player_t::get_cooldown( const std::string& name )
   {
     c = new cooldown_t( name, *this );
 
-    cooldown_list.push_back( c );
+    add_indexed( *this, cooldown_index, cooldown_list, c );
   }
 
   return c;
@@ -6048,6 +6292,13 @@ real_ppm_t* player_t::get_rppm( const std::string& name, double freq, double mod
   return new_rppm;
 }
 
+// player_t::register_buff ==================================================
+
+void player_t::register_buff( buff_t* buff )
+{
+  add_indexed( *this, buff_index, buff_list, buff );
+}
+
 // player_t::get_dot ========================================================
 
 dot_t* player_t::get_dot( const std::string& name,
@@ -6058,7 +6309,7 @@ dot_t* player_t::get_dot( const std::string& name,
   if ( ! d )
   {
     d = new dot_t( name, this, source );
-    dot_list.push_back( d );
+    add_indexed( *this, dot_index, dot_list, d );
   }
 
   return d;
@@ -6074,7 +6325,7 @@ gain_t* player_t::get_gain( const std::string& name )
   {
     g = new gain_t( name );
 
-    gain_list.push_back( g );
+    add_indexed( *this, gain_index, gain_list, g );
   }
 
   return g;
@@ -6090,7 +6341,7 @@ proc_t* player_t::get_proc( const std::string& name )
   {
     p = new proc_t( *sim, name );
 
-    proc_list.push_back( p );
+    add_indexed( *this, proc_index, proc_list, p );
   }
 
   return p;
@@ -6106,7 +6357,7 @@ luxurious_sample_data_t* player_t::get_sample_data( const std::string& name )
   {
     sd = new luxurious_sample_data_t( *this, name );
 
-    sample_data_list.push_back( sd );
+    add_indexed( *this, sample_data_index, sample_data_list, sd );
   }
 
   return sd;
@@ -6122,7 +6373,7 @@ stats_t* player_t::get_stats( const std::string& n, action_t* a )
   {
     stats = new stats_t( n, this );
 
-    stats_list.push_back( stats );
+    add_indexed( *this, stats_index, stats_list, stats );
   }
 
   assert( stats -> player == this );
@@ -6143,7 +6394,7 @@ benefit_t* player_t::get_benefit( const std::string& name )
   {
     u = new benefit_t( name );
 
-    benefit_list.push_back( u );
+    add_indexed( *this, benefit_index, benefit_list, u );
   }
 
   return u;
@@ -6160,7 +6411,7 @@ uptime_t* player_t::get_uptime( const std::string& name )
   {
     u = new uptime_t(  name );
 
-    uptime_list.push_back( u );
+    add_indexed( *this, uptime_index, uptime_list, u );
   }
 
   return u;
@@ -7478,8 +7729,230 @@ struct pool_resource_t : public action_t
 };
 
 
+// Action list optimization helpers ========================================
+
+bool always_true( expr_t* expr )
+{ return expr == nullptr || expr -> always_true(); }
+
+bool remove_action( std::vector<action_t*>& list, action_t* action )
+{
+  auto it = range::find( list, action );
+  if ( it == list.end() )
+    return false;
+
+  list.erase( it );
+  return true;
+}
+
+// Does any entry in the list before the given one refer to the variable
+bool variable_read_before( const std::vector<action_t*>& list, const action_t* action,
+                           const action_variable_t* var )
+{
+  std::string token = "variable." + var -> name_;
+  for ( auto a : list )
+  {
+    if ( a == action )
+      break;
+
+    if ( util::str_in_str_ci( a -> signature_str, token ) )
+      return true;
+  }
+
+  return false;
+}
+
+// pool_resource,for_next=1 resolves the entry following it lazily on reset,
+// that entry has to stay in place even if it can never be executed.
+bool pooled_for( const std::vector<action_t*>& list, const action_t* action )
+{
+  auto it = std::find( list.begin(), list.end(), action );
+  if ( it == list.end() || it == list.begin() )
+    return false;
+
+  const pool_resource_t* pool = dynamic_cast<const pool_resource_t*>( *( it - 1 ) );
+  return pool && pool -> for_next && ! pool -> next_action;
+}
+
+/* The single value a variable can ever hold, if any. All assignments have to
+ * set the same constant value, and the variable must hold that value from the
+ * start of combat: either it is the default value, or the variable is set
+ * unconditionally in the precombat list before anything reads it. A reset
+ * restores the default value, so then the value has to be the default too.
+ */
+bool constant_variable_value( const player_t& p, const action_variable_t* var, double& value )
+{
+  bool found = false, initialized = false, reset = false;
+
+  for ( auto a : p.action_list )
+  {
+    if ( a -> type != ACTION_VARIABLE || a -> background )
+      continue;
+
+    const variable_t* v = debug_cast<const variable_t*>( a );
+    if ( v -> var != var )
+      continue;
+
+    switch ( v -> operation )
+    {
+      case OPERATION_SET:
+      {
+        double v_value;
+        if ( ! v -> value_expression || ! v -> value_expression -> is_constant( &v_value ) )
+          return false;
+
+        if ( found && v_value != value )
+          return false;
+
+        value = v_value;
+        found = true;
+
+        if ( ! p.is_pet() && ! p.is_add() && always_true( v -> if_expr ) &&
+             range::find( p.precombat_action_list, a ) != p.precombat_action_list.end() &&
+             ! variable_read_before( p.precombat_action_list, a, var ) )
+        {
+          initialized = true;
+        }
+        break;
+      }
+      case OPERATION_RESET:
+        reset = true;
+        break;
+      case OPERATION_PRINT:
+        break;
+      default:
+        return false;
+    }
+  }
+
+  if ( ! found || ( reset && value != var -> default_ ) )
+    return false;
+
+  return initialized || value == var -> default_;
+}
+
 } // UNNAMED NAMESPACE
 
+// player_t::optimize_action_lists ==========================================
+
+/* Whole action list constant folding, done once all actors have finished
+ * initialization. Variables that can only hold a single value become
+ * constants, entries with a statically false condition and calls to empty
+ * action lists are removed, and statically true conditions are replaced by a
+ * constant. Conditions are only evaluated statically, the analyzing expression
+ * trees are still optimized after the first iteration.
+ */
+void player_t::optimize_action_lists( apl_optimization_t& stats )
+{
+  stats.entries += as<unsigned>( precombat_action_list.size() );
+  for ( auto apl : action_priority_list )
+    stats.entries += as<unsigned>( apl -> foreground_action_list.size() );
+
+  // Skill based false positives make actions usable regardless of their condition
+  bool distraction = range::find_if( sim -> raid_events, []( const std::unique_ptr<raid_event_t>& e ) {
+    return e -> name_str == "distraction"; } ) != sim -> raid_events.end();
+
+  // Resolve constant variables first, they may turn conditions (and the values
+  // of other variables) constant.
+  bool changed = true;
+  while ( changed )
+  {
+    changed = false;
+    for ( auto var : variables )
+    {
+      double value = 0;
+      if ( var -> constant_ || ! constant_variable_value( *this, var, value ) )
+        continue;
+
+      if ( sim -> debug )
+        sim -> out_debug.printf( "%s variable %s is constant %f", name(), var -> name_.c_str(), value );
+
+      var -> default_ = var -> current_value_ = value;
+      var -> constant_ = true;
+      stats.constant_variables++;
+      changed = true;
+    }
+  }
+
+  for ( auto a : action_list )
+  {
+    if ( a -> background || ( a -> action_list && a -> action_list -> random ) )
+      continue;
+
+    unsigned* removed = nullptr;
+
+    if ( a -> type == ACTION_VARIABLE && debug_cast<variable_t*>( a ) -> var -> constant_ &&
+         debug_cast<variable_t*>( a ) -> operation != OPERATION_PRINT )
+    {
+      removed = &stats.variable_entries;
+    }
+    else if ( a -> if_expr && a -> if_expr -> always_false() && a -> action_skill == 1 &&
+              ( ! distraction || a -> ignore_false_positive ) )
+    {
+      removed = &stats.false_conditions;
+    }
+    else if ( a -> if_expr && a -> if_expr -> op_ != expression::TOK_NUM && a -> if_expr -> always_true() )
+    {
+      delete a -> if_expr;
+      a -> if_expr = expr_t::create_constant( "if_always_true", 1.0 );
+      stats.true_conditions++;
+    }
+
+    if ( ! removed )
+      continue;
+
+    if ( a -> action_list && pooled_for( a -> action_list -> foreground_action_list, a ) )
+      continue;
+
+    bool in_list = remove_action( precombat_action_list, a );
+    if ( a -> action_list )
+    {
+      in_list = remove_action( a -> action_list -> foreground_action_list, a ) || in_list;
+      remove_action( a -> action_list -> off_gcd_actions, a );
+    }
+
+    if ( in_list )
+    {
+      ( *removed )++;
+      if ( sim -> debug )
+        sim -> out_debug.printf( "%s removes constant action list entry %s", name(), a -> signature_str.c_str() );
+    }
+  }
+
+  // Calls to empty action lists do nothing, removing them may empty further lists
+  changed = true;
+  while ( changed )
+  {
+    changed = false;
+    for ( auto apl : action_priority_list )
+    {
+      if ( apl -> random )
+        continue;
+
+      auto& list = apl -> foreground_action_list;
+      for ( size_t i = 0; i < list.size(); )
+      {
+        action_t* a = list[ i ];
+        const call_action_list_t* call = a -> type == ACTION_CALL ? debug_cast<call_action_list_t*>( a ) : nullptr;
+        if ( call && call -> alist && call -> alist -> foreground_action_list.empty() &&
+             ! pooled_for( list, a ) )
+        {
+          if ( sim -> debug )
+            sim -> out_debug.printf( "%s removes call to empty action list %s", name(), a -> signature_str.c_str() );
+
+          list.erase( list.begin() + i );
+          remove_action( apl -> off_gcd_actions, a );
+          stats.empty_calls++;
+          changed = true;
+        }
+        else
+        {
+          ++i;
+        }
+      }
+    }
+  }
+}
+
 // player_t::create_action ==================================================
 
 action_t* player_t::create_action( const std::string& name,
@@ -8756,6 +9229,15 @@ expr_t* player_t::create_expression( action_t* a,
 
       double evaluate() override
       { return var_ -> current_value_; }
+
+      bool is_constant( double* v ) override
+      {
+        if ( ! var_ -> constant_ )
+          return false;
+
+        *v = var_ -> default_;
+        return true;
+      }
     };
 
     variable_expr_t* expr = new variable_expr_t( this, splits[ 1 ] );
@@ -9032,7 +9514,7 @@ expr_t* player_t::create_expression( action_t* a,
     if ( splits[ 0 ] == "buff" || splits[ 0 ] == "debuff" )
     {
       a -> player -> get_target_data( this );
-      buff_t* buff = buff_t::find_expressable( buff_list, splits[ 1 ], a -> player );
+      buff_t* buff = buff_t::find_expressable( this, splits[ 1 ], a -> player );
       if ( ! buff ) buff = buff_t::find( this, splits[ 1 ], this ); // Raid debuffs
       if ( buff ) return buff_t::create_expression( splits[ 1 ], a, splits[ 2 ], buff );
     }
@@ -10064,6 +10546,12 @@ void player_t::analyze( sim_t& s )
 
   pre_analyze_hook();
 
+  if ( minimal_data_collection )
+  {
+    collected_data.analyze_minimal();
+    return;
+  }
+
   // Sample Data Analysis ===================================================
 
   // sample_data_t::analyze(calc_basics,calc_variance,sort )
@@ -10237,33 +10725,47 @@ void player_stat_cache_t::invalidate_all()
 {
   if ( ! active ) return;
 
-  range::fill( valid, false );
-  range::fill( spell_power_valid, false );
-  range::fill( player_mult_valid, false );
-  range::fill( player_heal_mult_valid, false );
+  valid.reset();
+  spell_power_valid.reset();
+  player_mult_valid.reset();
+  player_heal_mult_valid.reset();
 }
 
-/* Invalidate ALL stats
+/* Invalidate a single stat
  */
 void player_stat_cache_t::invalidate( cache_e c )
 {
   switch ( c )
   {
     case CACHE_SPELL_POWER:
-      range::fill( spell_power_valid, false );
+      spell_power_valid.reset();
       break;
     case CACHE_PLAYER_DAMAGE_MULTIPLIER:
-      range::fill( player_mult_valid, false );
+      player_mult_valid.reset();
       break;
     case CACHE_PLAYER_HEAL_MULTIPLIER:
-      range::fill( player_heal_mult_valid, false );
+      player_heal_mult_valid.reset();
       break;
     default:
-      valid[ c ] = false;
+      valid.reset( c );
       break;
   }
 }
 
+/* Invalidate all stats in the mask
+ */
+void player_stat_cache_t::invalidate( const mask_t& mask )
+{
+  valid &= ~mask;
+
+  if ( mask.test( CACHE_SPELL_POWER ) )
+    spell_power_valid.reset();
+  if ( mask.test( CACHE_PLAYER_DAMAGE_MULTIPLIER ) )
+    player_mult_valid.reset();
+  if ( mask.test( CACHE_PLAYER_HEAL_MULTIPLIER ) )
+    player_heal_mult_valid.reset();
+}
+
 /* Helper function to access attribute cache functions by attribute-enumeration
  */
 double player_stat_cache_t::get_attribute( attribute_e a ) const
@@ -10288,10 +10790,10 @@ double player_stat_cache_t::strength() const
   if ( ! active || ! valid[ CACHE_STRENGTH ] )
   {
     valid[ CACHE_STRENGTH ] = true;
-    _strength = player -> strength();
+    _value[ CACHE_STRENGTH ] = player -> strength();
   }
-  else assert( _strength == player -> strength() );
-  return _strength;
+  else assert( _value[ CACHE_STRENGTH ] == player -> strength() );
+  return _value[ CACHE_STRENGTH ];
 }
 
 // player_stat_cache_t::agiity ==============================================
@@ -10301,10 +10803,10 @@ double player_stat_cache_t::agility() const
   if ( ! active || ! valid[ CACHE_AGILITY ] )
   {
     valid[ CACHE_AGILITY ] = true;
-    _agility = player -> agility();
+    _value[ CACHE_AGILITY ] = player -> agility();
   }
-  else assert( _agility == player -> agility() );
-  return _agility;
+  else assert( _value[ CACHE_AGILITY ] == player -> agility() );
+  return _value[ CACHE_AGILITY ];
 }
 
 // player_stat_cache_t::stamina =============================================
@@ -10314,10 +10816,10 @@ double player_stat_cache_t::stamina() const
   if ( ! active || ! valid[ CACHE_STAMINA ] )
   {
     valid[ CACHE_STAMINA ] = true;
-    _stamina = player -> stamina();
+    _value[ CACHE_STAMINA ] = player -> stamina();
   }
-  else assert( _stamina == player -> stamina() );
-  return _stamina;
+  else assert( _value[ CACHE_STAMINA ] == player -> stamina() );
+  return _value[ CACHE_STAMINA ];
 }
 
 // player_stat_cache_t::intellect ===========================================
@@ -10327,10 +10829,10 @@ double player_stat_cache_t::intellect() const
   if ( ! active || ! valid[ CACHE_INTELLECT ] )
   {
     valid[ CACHE_INTELLECT ] = true;
-    _intellect = player -> intellect();
+    _value[ CACHE_INTELLECT ] = player -> intellect();
   }
-  else assert( _intellect == player -> intellect() );
-  return _intellect;
+  else assert( _value[ CACHE_INTELLECT ] == player -> intellect() );
+  return _value[ CACHE_INTELLECT ];
 }
 
 // player_stat_cache_t::spirit ==============================================
@@ -10340,10 +10842,10 @@ double player_stat_cache_t::spirit() const
   if ( ! active || ! valid[ CACHE_SPIRIT ] )
   {
     valid[ CACHE_SPIRIT ] = true;
-    _spirit = player -> spirit();
+    _value[ CACHE_SPIRIT ] = player -> spirit();
   }
-  else assert( _spirit == player -> spirit() );
-  return _spirit;
+  else assert( _value[ CACHE_SPIRIT ] == player -> spirit() );
+  return _value[ CACHE_SPIRIT ];
 }
 
 // player_stat_cache_t::spell_power =========================================
@@ -10366,10 +10868,10 @@ double player_stat_cache_t::attack_power() const
   if ( ! active || ! valid[ CACHE_ATTACK_POWER ] )
   {
     valid[ CACHE_ATTACK_POWER ] = true;
-    _attack_power = player -> composite_melee_attack_power();
+    _value[ CACHE_ATTACK_POWER ] = player -> composite_melee_attack_power();
   }
-  else assert( _attack_power == player -> composite_melee_attack_power() );
-  return _attack_power;
+  else assert( _value[ CACHE_ATTACK_POWER ] == player -> composite_melee_attack_power() );
+  return _value[ CACHE_ATTACK_POWER ];
 }
 
 // player_stat_cache_t::attack_expertise ====================================
@@ -10379,10 +10881,10 @@ double player_stat_cache_t::attack_expertise() const
   if ( ! active || ! valid[ CACHE_ATTACK_EXP ] )
   {
     valid[ CACHE_ATTACK_EXP ] = true;
-    _attack_expertise = player -> composite_melee_expertise();
+    _value[ CACHE_ATTACK_EXP ] = player -> composite_melee_expertise();
   }
-  else assert( _attack_expertise == player -> composite_melee_expertise() );
-  return _attack_expertise;
+  else assert( _value[ CACHE_ATTACK_EXP ] == player -> composite_melee_expertise() );
+  return _value[ CACHE_ATTACK_EXP ];
 }
 
 // player_stat_cache_t::attack_hit ==========================================
@@ -10392,17 +10894,17 @@ double player_stat_cache_t::attack_hit() const
   if ( ! active || ! valid[ CACHE_ATTACK_HIT ] )
   {
     valid[ CACHE_ATTACK_HIT ] = true;
-    _attack_hit = player -> composite_melee_hit();
+    _value[ CACHE_ATTACK_HIT ] = player -> composite_melee_hit();
   }
   else
   {
-    if ( _attack_hit != player -> composite_melee_hit() )
+    if ( _value[ CACHE_ATTACK_HIT ] != player -> composite_melee_hit() )
     {
       assert( false );
     }
-    // assert( _attack_hit == player -> composite_attack_hit() );
+    // assert( _value[ CACHE_ATTACK_HIT ] == player -> composite_attack_hit() );
   }
-  return _attack_hit;
+  return _value[ CACHE_ATTACK_HIT ];
 }
 
 // player_stat_cache_t::attack_crit_chance =========================================
@@ -10412,10 +10914,10 @@ double player_stat_cache_t::attack_crit_chance() const
   if ( ! active || ! valid[ CACHE_ATTACK_CRIT_CHANCE ] )
   {
     valid[ CACHE_ATTACK_CRIT_CHANCE ] = true;
-    _attack_crit_chance = player -> composite_melee_crit_chance();
+    _value[ CACHE_ATTACK_CRIT_CHANCE ] = player -> composite_melee_crit_chance();
   }
-  else assert( _attack_crit_chance == player -> composite_melee_crit_chance() );
-  return _attack_crit_chance;
+  else assert( _value[ CACHE_ATTACK_CRIT_CHANCE ] == player -> composite_melee_crit_chance() );
+  return _value[ CACHE_ATTACK_CRIT_CHANCE ];
 }
 
 // player_stat_cache_t::attack_haste ========================================
@@ -10425,10 +10927,10 @@ double player_stat_cache_t::attack_haste() const
   if ( ! active || ! valid[ CACHE_ATTACK_HASTE ] )
   {
     valid[ CACHE_ATTACK_HASTE ] = true;
-    _attack_haste = player -> composite_melee_haste();
+    _value[ CACHE_ATTACK_HASTE ] = player -> composite_melee_haste();
   }
-  else assert( _attack_haste == player -> composite_melee_haste() );
-  return _attack_haste;
+  else assert( _value[ CACHE_ATTACK_HASTE ] == player -> composite_melee_haste() );
+  return _value[ CACHE_ATTACK_HASTE ];
 }
 
 // player_stat_cache_t::attack_speed ========================================
@@ -10438,10 +10940,10 @@ double player_stat_cache_t::attack_speed() const
   if ( ! active || ! valid[ CACHE_ATTACK_SPEED ] )
   {
     valid[ CACHE_ATTACK_SPEED ] = true;
-    _attack_speed = player -> composite_melee_speed();
+    _value[ CACHE_ATTACK_SPEED ] = player -> composite_melee_speed();
   }
-  else assert( _attack_speed == player -> composite_melee_speed() );
-  return _attack_speed;
+  else assert( _value[ CACHE_ATTACK_SPEED ] == player -> composite_melee_speed() );
+  return _value[ CACHE_ATTACK_SPEED ];
 }
 
 // player_stat_cache_t::spell_hit ===========================================
@@ -10451,10 +10953,10 @@ double player_stat_cache_t::spell_hit() const
   if ( ! active || ! valid[ CACHE_SPELL_HIT ] )
   {
     valid[ CACHE_SPELL_HIT ] = true;
-    _spell_hit = player -> composite_spell_hit();
+    _value[ CACHE_SPELL_HIT ] = player -> composite_spell_hit();
   }
-  else assert( _spell_hit == player -> composite_spell_hit() );
-  return _spell_hit;
+  else assert( _value[ CACHE_SPELL_HIT ] == player -> composite_spell_hit() );
+  return _value[ CACHE_SPELL_HIT ];
 }
 
 // player_stat_cache_t::spell_crit_chance ==========================================
@@ -10464,10 +10966,10 @@ double player_stat_cache_t::spell_crit_chance() const
   if ( ! active || ! valid[ CACHE_SPELL_CRIT_CHANCE ] )
   {
     valid[ CACHE_SPELL_CRIT_CHANCE ] = true;
-    _spell_crit_chance = player -> composite_spell_crit_chance();
+    _value[ CACHE_SPELL_CRIT_CHANCE ] = player -> composite_spell_crit_chance();
   }
-  else assert( _spell_crit_chance == player -> composite_spell_crit_chance() );
-  return _spell_crit_chance;
+  else assert( _value[ CACHE_SPELL_CRIT_CHANCE ] == player -> composite_spell_crit_chance() );
+  return _value[ CACHE_SPELL_CRIT_CHANCE ];
 }
 
 // player_stat_cache_t::spell_haste =========================================
@@ -10477,10 +10979,10 @@ double player_stat_cache_t::spell_haste() const
   if ( ! active || ! valid[ CACHE_SPELL_HASTE ] )
   {
     valid[ CACHE_SPELL_HASTE ] = true;
-    _spell_haste = player -> composite_spell_haste();
+    _value[ CACHE_SPELL_HASTE ] = player -> composite_spell_haste();
   }
-  else assert( _spell_haste == player -> composite_spell_haste() );
-  return _spell_haste;
+  else assert( _value[ CACHE_SPELL_HASTE ] == player -> composite_spell_haste() );
+  return _value[ CACHE_SPELL_HASTE ];
 }
 
 // player_stat_cache_t::spell_speed =========================================
@@ -10490,10 +10992,10 @@ double player_stat_cache_t::spell_speed() const
   if ( ! active || ! valid[ CACHE_SPELL_SPEED ] )
   {
     valid[ CACHE_SPELL_SPEED ] = true;
-    _spell_speed = player -> composite_spell_speed();
+    _value[ CACHE_SPELL_SPEED ] = player -> composite_spell_speed();
   }
-  else assert( _spell_speed == player -> composite_spell_speed() );
-  return _spell_speed;
+  else assert( _value[ CACHE_SPELL_SPEED ] == player -> composite_spell_speed() );
+  return _value[ CACHE_SPELL_SPEED ];
 }
 
 double player_stat_cache_t::dodge() const
@@ -10501,10 +11003,10 @@ double player_stat_cache_t::dodge() const
   if ( ! active || ! valid[ CACHE_DODGE ] )
   {
     valid[ CACHE_DODGE ] = true;
-    _dodge = player -> composite_dodge();
+    _value[ CACHE_DODGE ] = player -> composite_dodge();
   }
-  else assert( _dodge == player -> composite_dodge() );
-  return _dodge;
+  else assert( _value[ CACHE_DODGE ] == player -> composite_dodge() );
+  return _value[ CACHE_DODGE ];
 }
 
 double player_stat_cache_t::parry() const
@@ -10512,10 +11014,10 @@ double player_stat_cache_t::parry() const
   if ( ! active || ! valid[ CACHE_PARRY ] )
   {
     valid[ CACHE_PARRY ] = true;
-    _parry = player -> composite_parry();
+    _value[ CACHE_PARRY ] = player -> composite_parry();
   }
-  else assert( _parry == player -> composite_parry() );
-  return _parry;
+  else assert( _value[ CACHE_PARRY ] == player -> composite_parry() );
+  return _value[ CACHE_PARRY ];
 }
 
 double player_stat_cache_t::block() const
@@ -10523,10 +11025,10 @@ double player_stat_cache_t::block() const
   if ( ! active || ! valid[ CACHE_BLOCK ] )
   {
     valid[ CACHE_BLOCK ] = true;
-    _block = player -> composite_block();
+    _value[ CACHE_BLOCK ] = player -> composite_block();
   }
-  else assert( _block == player -> composite_block() );
-  return _block;
+  else assert( _value[ CACHE_BLOCK ] == player -> composite_block() );
+  return _value[ CACHE_BLOCK ];
 }
 
 double player_stat_cache_t::crit_block() const
@@ -10534,10 +11036,10 @@ double player_stat_cache_t::crit_block() const
   if ( ! active || ! valid[ CACHE_CRIT_BLOCK ] )
   {
     valid[ CACHE_CRIT_BLOCK ] = true;
-    _crit_block = player -> composite_crit_block();
+    _value[ CACHE_CRIT_BLOCK ] = player -> composite_crit_block();
   }
-  else assert( _crit_block == player -> composite_crit_block() );
-  return _crit_block;
+  else assert( _value[ CACHE_CRIT_BLOCK ] == player -> composite_crit_block() );
+  return _value[ CACHE_CRIT_BLOCK ];
 }
 
 double player_stat_cache_t::crit_avoidance() const
@@ -10545,10 +11047,10 @@ double player_stat_cache_t::crit_avoidance() const
   if ( ! active || ! valid[ CACHE_CRIT_AVOIDANCE ] )
   {
     valid[ CACHE_CRIT_AVOIDANCE ] = true;
-    _crit_avoidance = player -> composite_crit_avoidance();
+    _value[ CACHE_CRIT_AVOIDANCE ] = player -> composite_crit_avoidance();
   }
-  else assert( _crit_avoidance == player -> composite_crit_avoidance() );
-  return _crit_avoidance;
+  else assert( _value[ CACHE_CRIT_AVOIDANCE ] == player -> composite_crit_avoidance() );
+  return _value[ CACHE_CRIT_AVOIDANCE ];
 }
 
 double player_stat_cache_t::miss() const
@@ -10556,10 +11058,10 @@ double player_stat_cache_t::miss() const
   if ( ! active || ! valid[ CACHE_MISS ] )
   {
     valid[ CACHE_MISS ] = true;
-    _miss = player -> composite_miss();
+    _value[ CACHE_MISS ] = player -> composite_miss();
   }
-  else assert( _miss == player -> composite_miss() );
-  return _miss;
+  else assert( _value[ CACHE_MISS ] == player -> composite_miss() );
+  return _value[ CACHE_MISS ];
 }
 
 double player_stat_cache_t::armor() const
@@ -10567,10 +11069,10 @@ double player_stat_cache_t::armor() const
   if ( ! active || ! valid[ CACHE_ARMOR ] || ! valid[ CACHE_BONUS_ARMOR ] )
   {
     valid[ CACHE_ARMOR ] = true;
-    _armor = player -> composite_armor();
+    _value[ CACHE_ARMOR ] = player -> composite_armor();
   }
-  else assert( _armor == player -> composite_armor() );
-  return _armor;
+  else assert( _value[ CACHE_ARMOR ] == player -> composite_armor() );
+  return _value[ CACHE_ARMOR ];
 }
 
 double player_stat_cache_t::mastery() const
@@ -10578,11 +11080,11 @@ double player_stat_cache_t::mastery() const
   if ( ! active || ! valid[ CACHE_MASTERY ] )
   {
     valid[ CACHE_MASTERY ] = true;
-    _mastery = player -> composite_mastery();
+    _value[ CACHE_MASTERY ] = player -> composite_mastery();
     _mastery_value = player -> composite_mastery_value();
   }
-  else assert( _mastery == player -> composite_mastery() );
-  return _mastery;
+  else assert( _value[ CACHE_MASTERY ] == player -> composite_mastery() );
+  return _value[ CACHE_MASTERY ];
 }
 
 /* This is composite_mastery * specialization_mastery_coefficient !
@@ -10594,7 +11096,7 @@ double player_stat_cache_t::mastery_value() const
   if ( ! active || ! valid[ CACHE_MASTERY ] )
   {
     valid[ CACHE_MASTERY ] = true;
-    _mastery = player -> composite_mastery();
+    _value[ CACHE_MASTERY ] = player -> composite_mastery();
     _mastery_value = player -> composite_mastery_value();
   }
   else assert( _mastery_value == player -> composite_mastery_value() );
@@ -10606,10 +11108,10 @@ double player_stat_cache_t::bonus_armor() const
   if ( ! active || ! valid[ CACHE_BONUS_ARMOR ] )
   {
     valid[ CACHE_BONUS_ARMOR ] = true;
-    _bonus_armor = player -> composite_bonus_armor();
+    _value[ CACHE_BONUS_ARMOR ] = player -> composite_bonus_armor();
   }
-  else assert( _bonus_armor == player -> composite_bonus_armor() );
-  return _bonus_armor;
+  else assert( _value[ CACHE_BONUS_ARMOR ] == player -> composite_bonus_armor() );
+  return _value[ CACHE_BONUS_ARMOR ];
 }
 
 double player_stat_cache_t::damage_versatility() const
@@ -10617,10 +11119,10 @@ double player_stat_cache_t::damage_versatility() const
   if ( ! active || ! valid[ CACHE_DAMAGE_VERSATILITY ] )
   {
     valid[ CACHE_DAMAGE_VERSATILITY ] = true;
-    _damage_versatility = player -> composite_damage_versatility();
+    _value[ CACHE_DAMAGE_VERSATILITY ] = player -> composite_damage_versatility();
   }
-  else assert( _damage_versatility == player -> composite_damage_versatility() );
-  return _damage_versatility;
+  else assert( _value[ CACHE_DAMAGE_VERSATILITY ] == player -> composite_damage_versatility() );
+  return _value[ CACHE_DAMAGE_VERSATILITY ];
 }
 
 double player_stat_cache_t::heal_versatility() const
@@ -10628,10 +11130,10 @@ double player_stat_cache_t::heal_versatility() const
   if ( ! active || ! valid[ CACHE_HEAL_VERSATILITY ] )
   {
     valid[ CACHE_HEAL_VERSATILITY ] = true;
-    _heal_versatility = player -> composite_heal_versatility();
+    _value[ CACHE_HEAL_VERSATILITY ] = player -> composite_heal_versatility();
   }
-  else assert( _heal_versatility == player -> composite_heal_versatility() );
-  return _heal_versatility;
+  else assert( _value[ CACHE_HEAL_VERSATILITY ] == player -> composite_heal_versatility() );
+  return _value[ CACHE_HEAL_VERSATILITY ];
 }
 
 double player_stat_cache_t::mitigation_versatility() const
@@ -10639,10 +11141,10 @@ double player_stat_cache_t::mitigation_versatility() const
   if ( ! active || ! valid[ CACHE_MITIGATION_VERSATILITY ] )
   {
     valid[ CACHE_MITIGATION_VERSATILITY ] = true;
-    _mitigation_versatility = player -> composite_mitigation_versatility();
+    _value[ CACHE_MITIGATION_VERSATILITY ] = player -> composite_mitigation_versatility();
   }
-  else assert( _mitigation_versatility == player -> composite_mitigation_versatility() );
-  return _mitigation_versatility;
+  else assert( _value[ CACHE_MITIGATION_VERSATILITY ] == player -> composite_mitigation_versatility() );
+  return _value[ CACHE_MITIGATION_VERSATILITY ];
 }
 
 double player_stat_cache_t::leech() const
@@ -10650,10 +11152,10 @@ double player_stat_cache_t::leech() const
   if ( ! active || ! valid[ CACHE_LEECH ] )
   {
     valid[ CACHE_LEECH ] = true;
-    _leech = player -> composite_leech();
+    _value[ CACHE_LEECH ] = player -> composite_leech();
   }
-  else assert( _leech == player -> composite_leech() );
-  return _leech;
+  else assert( _value[ CACHE_LEECH ] == player -> composite_leech() );
+  return _value[ CACHE_LEECH ];
 }
 
 double player_stat_cache_t::run_speed() const
@@ -10661,10 +11163,10 @@ double player_stat_cache_t::run_speed() const
   if ( !active || !valid[ CACHE_RUN_SPEED ] )
   {
     valid[ CACHE_RUN_SPEED ] = true;
-    _run_speed = player -> composite_movement_speed();
+    _value[ CACHE_RUN_SPEED ] = player -> composite_movement_speed();
   }
-  else assert( _run_speed == player -> composite_movement_speed() );
-  return _run_speed;
+  else assert( _value[ CACHE_RUN_SPEED ] == player -> composite_movement_speed() );
+  return _value[ CACHE_RUN_SPEED ];
 }
 
 double player_stat_cache_t::avoidance() const
@@ -10672,10 +11174,10 @@ double player_stat_cache_t::avoidance() const
   if ( !active || !valid[ CACHE_AVOIDANCE ] )
   {
     valid[ CACHE_AVOIDANCE ] = true;
-    _avoidance = player -> composite_avoidance();
+    _value[ CACHE_AVOIDANCE ] = player -> composite_avoidance();
   }
-  else assert( _avoidance == player -> composite_avoidance() );
-  return _avoidance;
+  else assert( _value[ CACHE_AVOIDANCE ] == player -> composite_avoidance() );
+  return _value[ CACHE_AVOIDANCE ];
 }
 
 // player_stat_cache_t::player_multiplier =============================================
@@ -10708,51 +11210,123 @@ double player_stat_cache_t::player_heal_multiplier( const action_state_t* s ) co
 
 #endif
 
-player_collected_data_t::action_sequence_data_t::action_sequence_data_t( const action_t* a, const player_t* t, const timespan_t& ts, const player_t* p ) :
-  action( a ), target( t ), time( ts ), wait_time( timespan_t::zero() )
+// action_sequence_t::reserve ==============================================
+
+void action_sequence_t::reserve( size_t n_entries )
+{
+  entries.reserve( n_entries );
+  // Buff snapshots are deduplicated against the previous entry, so this is a generous estimate
+  buffs.reserve( n_entries * 4 );
+  resources.reserve( n_entries * 2 );
+}
+
+// action_sequence_t::clear ================================================
+
+void action_sequence_t::clear()
 {
-  for ( size_t i = 0; i < p -> buff_list.size(); ++i )
+  entries.clear();
+  buffs.clear();
+  resources.clear();
+  iterations.clear();
+}
+
+// action_sequence_t::add ==================================================
+
+action_sequence_t::entry_t& action_sequence_t::add( int iteration, const action_t* a,
+                                                    const player_t* target, const timespan_t& time,
+                                                    const timespan_t& wait_time, const player_t* p )
+{
+  if ( iterations.empty() || iterations.back().iteration != iteration )
+  {
+    iteration_t it;
+    it.iteration = iteration;
+    it.begin = it.end = entries.size();
+    iterations.push_back( it );
+  }
+
+  entry_t e;
+  e.action = a;
+  e.target = target;
+  e.time = time;
+  e.wait_time = wait_time;
+  e.precombat = ! p -> in_combat;
+
+  // Snapshot the buffs at the end of the shared buffer, and drop the new snapshot in favor of the
+  // previous entry's range if nothing changed.
+  size_t buff_begin = buffs.size();
+  for ( size_t i = 0, end = p -> buff_list.size(); i < end; ++i )
   {
     buff_t* b = p -> buff_list[ i ];
     if ( b -> check() && ! b -> quiet && ! b -> constant )
-      buff_list.push_back( std::make_pair( b, b -> check() ) );
+    {
+      buff_snapshot_t snapshot;
+      snapshot.buff = b;
+      snapshot.stacks = b -> check();
+      buffs.push_back( snapshot );
+    }
   }
 
-  range::fill( resource_snapshot, -1 );
-  range::fill( resource_max_snapshot, -1 );
+  e.buff_begin = static_cast<unsigned>( buff_begin );
+  e.buff_end = static_cast<unsigned>( buffs.size() );
+
+  if ( iterations.back().end > iterations.back().begin )
+  {
+    const entry_t& prev = entries.back();
+    size_t n = buffs.size() - buff_begin;
+    if ( prev.buff_end - prev.buff_begin == n &&
+         std::equal( buffs.begin() + prev.buff_begin, buffs.begin() + prev.buff_end, buffs.begin() + buff_begin,
+           []( const buff_snapshot_t& l, const buff_snapshot_t& r ) { return l.buff == r.buff && l.stacks == r.stacks; } ) )
+    {
+      buffs.resize( buff_begin );
+      e.buff_begin = prev.buff_begin;
+      e.buff_end = prev.buff_end;
+    }
+  }
 
+  e.resource_begin = static_cast<unsigned>( resources.size() );
   for ( resource_e i = RESOURCE_HEALTH; i < RESOURCE_MAX; ++i )
   {
     if ( p -> resources.max[ i ] > 0.0 )
     {
-      resource_snapshot[ i ] = p -> resources.current[ i ];
-      resource_max_snapshot[ i ] = p -> resources.max[ i ];
+      resource_snapshot_t snapshot;
+      snapshot.resource = i;
+      snapshot.current = p -> resources.current[ i ];
+      snapshot.max = p -> resources.max[ i ];
+      resources.push_back( snapshot );
     }
   }
+  e.resource_end = static_cast<unsigned>( resources.size() );
+
+  entries.push_back( e );
+  iterations.back().end = entries.size();
+
+  return entries.back();
 }
 
-player_collected_data_t::action_sequence_data_t::action_sequence_data_t( const timespan_t& ts, const timespan_t& wait, const player_t* p ) :
-  action( 0 ), target( 0 ), time( ts ), wait_time( wait )
+// action_sequence_t::resource =============================================
+
+double action_sequence_t::resource( const entry_t& e, resource_e r ) const
 {
-  for ( size_t i = 0; i < p -> buff_list.size(); ++i )
+  for ( unsigned i = e.resource_begin; i < e.resource_end; ++i )
   {
-    buff_t* b = p -> buff_list[ i ];
-    if ( b -> check() && ! b -> quiet && ! b -> constant )
-      buff_list.push_back( std::make_pair( b, b -> check() ) );
+    if ( resources[ i ].resource == r )
+      return resources[ i ].current;
   }
 
-  range::fill( resource_snapshot, -1 );
-  range::fill( resource_max_snapshot, -1 );
+  return -1;
+}
 
-  for ( resource_e i = RESOURCE_HEALTH; i < RESOURCE_MAX; ++i )
-  {
-    if ( p -> resources.max[ i ] > 0.0 )
-    {
-      resource_snapshot[ i ] = p -> resources.current[ i ];
-      resource_max_snapshot[ i ] = p -> resources.max[ i ];
+// action_sequence_t::resource_max =========================================
 
-    }
+double action_sequence_t::resource_max( const entry_t& e, resource_e r ) const
+{
+  for ( unsigned i = e.resource_begin; i < e.resource_end; ++i )
+  {
+    if ( resources[ i ].resource == r )
+      return resources[ i ].max;
   }
+
+  return -1;
 }
 
 player_collected_data_t::player_collected_data_t( const std::string& player_name, sim_t& s ) :
@@ -10784,6 +11358,7 @@ player_collected_data_t::player_collected_data_t( const std::string& player_name
   effective_theck_meloree_index( player_name + "Theck-Meloree Index (Effective)", s.statistics_level < 1 ),
   max_spike_amount( player_name + " Max Spike Value", s.statistics_level < 1 ),
   target_metric( player_name + " Target Metric", false ),
+  iteration_target_metric( 0 ),
   resource_timelines(),
   combat_end_resource( RESOURCE_MAX ),
   stat_timelines(),
@@ -10794,6 +11369,9 @@ player_collected_data_t::player_collected_data_t( const std::string& player_name
 
 void player_collected_data_t::reserve_memory( const player_t& p )
 {
+  if ( p.minimal_data_collection )
+    return;
+
   int size = std::min( p.sim -> iterations, 10000 );
   fight_length.reserve( size );
   // DMG
@@ -10872,6 +11450,15 @@ void player_collected_data_t::merge( const player_collected_data_t& other )
   health_changes_tmi.merged_timeline.merge( other.health_changes_tmi.merged_timeline );
 }
 
+void player_collected_data_t::merge_minimal( const player_collected_data_t& other )
+{
+  fight_length.merge( other.fight_length );
+  dmg_taken.merge( other.dmg_taken );
+  dtps.merge( other.dtps );
+  heal_taken.merge( other.heal_taken );
+  htps.merge( other.htps );
+}
+
 void player_collected_data_t::analyze( const player_t& p )
 {
   fight_length.analyze();
@@ -10902,6 +11489,23 @@ void player_collected_data_t::analyze( const player_t& p )
   effective_theck_meloree_index.analyze();
   max_spike_amount.analyze();
 
+  // Sparse timelines hold value changes, turn them into values. The last bin only removes the
+  // values of the longest iteration. Periodic collection first samples at one second, so the
+  // first bin (holding the values at the start of combat) is cleared to match it.
+  if ( p.sim -> sparse_timelines )
+  {
+    auto densify = []( sc_timeline_t& tl ) {
+      if ( tl.data().empty() )
+        return;
+      tl.accumulate();
+      tl.resize( tl.data().size() - 1 );
+      if ( ! tl.data().empty() )
+        tl.add( timespan_t::zero(), -tl.data().front() );
+    };
+    range::for_each( resource_timelines, [ &densify ]( resource_timeline_t& tl ) { densify( tl.timeline ); } );
+    range::for_each( stat_timelines, [ &densify ]( stat_timeline_t& tl ) { densify( tl.timeline ); } );
+  }
+
   if ( ! p.sim -> single_actor_batch )
   {
     timeline_dmg_taken.adjust( *p.sim );
@@ -11028,6 +11632,26 @@ double player_collected_data_t::calculate_tmi( const health_changes_timeline_t&
   return tmi;
 }
 
+void player_collected_data_t::analyze_minimal()
+{
+  fight_length.analyze();
+  dmg_taken.analyze();
+  dtps.analyze();
+  heal_taken.analyze();
+  htps.analyze();
+}
+
+void player_collected_data_t::collect_minimal_data( const player_t& p )
+{
+  double f_length = p.iteration_fight_length.total_seconds();
+
+  fight_length.add( f_length );
+  dmg_taken.add( p.iteration_dmg_taken );
+  dtps.add( f_length ? p.iteration_dmg_taken / f_length : 0 );
+  heal_taken.add( p.iteration_heal_taken );
+  htps.add( f_length ? p.iteration_heal_taken / f_length : 0 );
+}
+
 void player_collected_data_t::collect_data( const player_t& p )
 {
   double f_length = p.iteration_fight_length.total_seconds();
@@ -11134,7 +11758,7 @@ void player_collected_data_t::collect_data( const player_t& p )
     max_spike_amount.add( max_spike * 100.0 );
   }
 
-  if ( p.sim -> target_error > 0 && ! p.is_pet() && ! p.is_enemy() )
+  if ( ( p.sim -> target_error > 0 || p.sim -> comparison -> enabled() ) && ! p.is_pet() && ! p.is_enemy() )
   {
     double metric=0;
 
@@ -11158,6 +11782,8 @@ void player_collected_data_t::collect_data( const player_t& p )
     default:;
     }
 
+    iteration_target_metric = metric;
+
     player_collected_data_t& cd = p.parent ? p.parent -> collected_data : *this;
 
     AUTO_LOCK( cd.target_metric_mutex );
@@ -11476,6 +12102,39 @@ void player_t::adjust_global_cooldown( haste_type_e haste_type )
   gcd_current_haste_value = new_haste;
 }
 
+// Rescale the dynamic cooldowns that are ticking down after a haste change. Cooldowns that are ready
+// are unaffected by the recharge multiplier, so they are dropped from the running list here and
+// re-added when they are started again. The running list keeps dynamic_cooldown_list order, so
+// cooldowns are adjusted (and their recharge events recreated) in the same order as before.
+void player_t::adjust_dynamic_cooldowns()
+{
+  size_t n = 0;
+  for ( size_t i = 0; i < running_dynamic_cooldowns.size(); ++i )
+  {
+    cooldown_t* cd = running_dynamic_cooldowns[ i ];
+    if ( cd -> up() )
+    {
+      cd -> dynamic_running = false;
+      continue;
+    }
+
+    cd -> adjust_recharge_multiplier();
+    running_dynamic_cooldowns[ n++ ] = cd;
+  }
+
+  running_dynamic_cooldowns.resize( n );
+}
+
+void player_t::add_running_dynamic_cooldown( cooldown_t* cd )
+{
+  assert( cd -> dynamic_index >= 0 && ! cd -> dynamic_running );
+
+  auto it = std::lower_bound( running_dynamic_cooldowns.begin(), running_dynamic_cooldowns.end(), cd,
+    []( const cooldown_t* a, const cooldown_t* b ) { return a -> dynamic_index < b -> dynamic_index; } );
+  running_dynamic_cooldowns.insert( it, cd );
+  cd -> dynamic_running = true;
+}
+
 void player_t::adjust_auto_attack( haste_type_e haste_type )
 {
   // Don't adjust autoattacks on spell-derived haste
@@ -11484,10 +12143,17 @@ void player_t::adjust_auto_attack( haste_type_e haste_type )
     return;
   }
 
+  // Swing timers only need rescheduling if the attack speed actually changed
+  double attack_speed = cache.attack_speed();
+  if ( attack_speed == current_attack_speed )
+  {
+    return;
+  }
+
   if ( main_hand_attack ) main_hand_attack -> reschedule_auto_attack( current_attack_speed );
   if ( off_hand_attack ) off_hand_attack -> reschedule_auto_attack( current_attack_speed );
 
-  current_attack_speed = cache.attack_speed();
+  current_attack_speed = attack_speed;
 }
 
 // Adjust the queue-delayed action execution if the ability currently being executed has a hasted
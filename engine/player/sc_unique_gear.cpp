@@ -3524,6 +3524,10 @@ void item::tyrants_decree( special_effect_t& effect )
       cancel_threshold = effect.driver() -> effectN( 2 ).percent();
     }
 
+    // Not gated by the proc cooldown, trigger() is fully overridden
+    const cooldown_t* dispatch_cooldown() const override
+    { return nullptr; }
+
     virtual void trigger( action_t* , void* ) override
     {
       if ( p -> resources.pct( RESOURCE_HEALTH ) < cancel_threshold )
@@ -4179,33 +4179,21 @@ struct spawn_of_serpentrix_t : public pet_t
 struct spawn_of_serpentrix_cb_t : public dbc_proc_callback_t
 {
   const spell_data_t* summon;
-  std::array<spawn_of_serpentrix_t*, 7> pets;
+  pet_pool_t<spawn_of_serpentrix_t> pets;
 
   spawn_of_serpentrix_cb_t( const special_effect_t& effect ) :
     dbc_proc_callback_t( effect.item, effect ),
     summon( effect.player -> find_spell( 215750 ) )
   {
-    for ( size_t i = 0; i < pets.size(); ++i )
+    for ( size_t i = 0; i < 7; ++i )
     {
-      pets[ i ] = new spawn_of_serpentrix_t( effect );
+      pets.add( new spawn_of_serpentrix_t( effect ) );
     }
   }
 
   void execute( action_t* /* a */, action_state_t* /* state */ ) override
   {
-    bool spawned = false;
-
-    for ( size_t i = 0; i < pets.size(); ++i )
-    {
-      if ( pets[ i ] -> is_sleeping() )
-      {
-        pets[ i ] -> summon( summon -> duration() );
-        spawned = true;
-        break;
-      }
-    }
-
-    if ( ! spawned )
+    if ( ! pets.spawn( summon -> duration() ) )
     {
       listener -> sim -> errorf( "%s spawn_of_serpentrix could not spawn a pet, increase the count",
         listener -> name() );
@@ -145,24 +145,60 @@ std::string chart_t::to_target_div() const
 
 std::string chart_t::to_data() const
 {
-  rapidjson::StringBuffer b;
-  sc_json_writer_t<rapidjson::StringBuffer> writer( b, sim_ );
-
-  js_.Accept( writer );
   std::string str_ = "{ \"target\": \"" + id_str_ + "\", \"data\": ";
-  str_ += b.GetString();
+  str_ += to_json_data();
   str_ += " }\n";
 
   return str_;
 }
 
-std::string chart_t::to_aggregate_string( bool on_click ) const
+// Highcharts options of the chart as compact JSON
+std::string chart_t::to_json_data() const
 {
   rapidjson::StringBuffer b;
   sc_json_writer_t<rapidjson::StringBuffer> writer( b, sim_ );
 
   js_.Accept( writer );
-  std::string javascript = b.GetString();
+
+  return std::string( b.GetString(), b.GetSize() );
+}
+
+std::string chart_t::to_json_options( const std::function<size_t( const std::string& )>& series_id ) const
+{
+  rapidjson::Document options;
+  options.CopyFrom( js_, options.GetAllocator() );
+
+  if ( options.HasMember( "series" ) && options[ "series" ].IsArray() )
+  {
+    rapidjson::Value& series = options[ "series" ];
+    for ( rapidjson::SizeType i = 0; i < series.Size(); ++i )
+    {
+      rapidjson::Value& s = series[ i ];
+      if ( ! s.IsObject() || ! s.HasMember( "data" ) )
+        continue;
+
+      rapidjson::StringBuffer b;
+      sc_json_writer_t<rapidjson::StringBuffer> writer( b, sim_ );
+      s[ "data" ].Accept( writer );
+
+      size_t id = series_id( std::string( b.GetString(), b.GetSize() ) );
+
+      s.RemoveMember( "data" );
+      s.AddMember( "__series", static_cast<uint64_t>( id ), options.GetAllocator() );
+    }
+  }
+
+  rapidjson::StringBuffer b;
+  sc_json_writer_t<rapidjson::StringBuffer> writer( b, sim_ );
+
+  options.Accept( writer );
+
+  return std::string( b.GetString(), b.GetSize() );
+}
+
+std::string chart_t::to_aggregate_string( bool on_click ) const
+{
+  std::string javascript = to_json_data();
 
   std::string str_;
   if ( on_click )
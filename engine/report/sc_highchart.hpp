@@ -6,6 +6,7 @@
 #define SC_HIGHCHART_HPP
 
 #include "interfaces/sc_js.hpp"
+#include <functional>
 
 struct sim_t;
 struct stats_t;
@@ -90,6 +91,10 @@ public:
   virtual std::string to_string() const;
   virtual std::string to_aggregate_string( bool on_click = true ) const;
   virtual std::string to_data() const;
+  virtual std::string to_json_data() const;
+  // Highcharts options with the data of each series replaced by the id the
+  // series_id callback gives for it (as a "__series" property)
+  std::string to_json_options( const std::function<size_t( const std::string& )>& series_id ) const;
   virtual std::string to_target_div() const;
   virtual std::string to_xml() const;
 };
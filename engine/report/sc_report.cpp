@@ -396,6 +396,33 @@ bool find_affix( const std::string& name, const std::string& data_name,
 
 }  // UNNAMED NAMESPACE ======================================================
 
+// report::sc_html_stream::sc_html_stream ==================================
+
+report::sc_html_stream::sc_html_stream() : buffer( BUFFER_SIZE )
+{ }
+
+// report::sc_html_stream::open ============================================
+
+void report::sc_html_stream::open( const char* filename, openmode mode )
+{
+  // libstdc++ only accepts a buffer before the file is opened, the MSVC
+  // library ignores one set before open() and only accepts it afterwards
+  // (before the first write). Install it on both sides of the open.
+  rdbuf()->pubsetbuf( buffer.data(), buffer.size() );
+  io::ofstream::open( filename, mode );
+  rdbuf()->pubsetbuf( buffer.data(), buffer.size() );
+}
+
+// report::sc_html_stream::~sc_html_stream =================================
+
+report::sc_html_stream::~sc_html_stream()
+{
+  // Flush while the buffer is still alive, the base class would only close
+  // the file after the buffer member is destroyed.
+  if ( is_open() )
+    close();
+}
+
 std::string report::pretty_spell_text( const spell_data_t& default_spell,
                                        const std::string& text,
                                        const player_t& p )
@@ -815,7 +842,7 @@ void report::print_spell_query( std::ostream& out, const sim_t& sim,
   }
 }
 
-void report::print_spell_query( xml_node_t* root, FILE* file, const sim_t& sim,
+void report::print_spell_query( xml_node_t* root, const sim_t& sim,
                                 const spell_data_expr_t& sq, unsigned level )
 {
   expr_data_e data_type = sq.data_type;
@@ -847,6 +874,12 @@ void report::print_spell_query( xml_node_t* root, FILE* file, const sim_t& sim,
       }
     }
   }
+}
+
+void report::print_spell_query( xml_node_t* root, FILE* file, const sim_t& sim,
+                                const spell_data_expr_t& sq, unsigned level )
+{
+  print_spell_query( root, sim, sq, level );
 
   util::fprintf( file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" );
   root->print_xml( file );
@@ -857,12 +890,26 @@ void report::print_suite( sim_t* sim )
 {
   std::cout << "\nGenerating reports...";
 
-  report::print_text( sim, sim->report_details != 0 );
-
-  report::print_html( *sim );
-  report::print_xml( sim );
-  report::print_json( *sim );
-  report::print_profiles( sim );
+  {
+    phase_timing_t::scope_t t( *sim->timing, "report_text" );
+    report::print_text( sim, sim->report_details != 0 );
+  }
+  {
+    phase_timing_t::scope_t t( *sim->timing, "report_html" );
+    report::print_html( *sim );
+  }
+  {
+    phase_timing_t::scope_t t( *sim->timing, "report_xml" );
+    report::print_xml( sim );
+  }
+  {
+    phase_timing_t::scope_t t( *sim->timing, "report_json" );
+    report::print_json( *sim );
+  }
+  {
+    phase_timing_t::scope_t t( *sim->timing, "report_profiles" );
+    report::print_profiles( sim );
+  }
 }
 
 void report::print_html_sample_data( report::sc_html_stream& os,
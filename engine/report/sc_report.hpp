@@ -9,6 +9,7 @@
 #include <array>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 #include "config.hpp"
 #include "sc_enums.hpp"
@@ -191,7 +192,23 @@ std::array<std::string, SCALE_METRIC_MAX> askmrrobot( const player_t& );
 // Report
 namespace report
 {
-using sc_html_stream = io::ofstream;
+// Output stream of the HTML report. The report is written append-only in one
+// pass, so the stream uses a large fixed buffer to keep the number of write
+// calls (and flushes) low regardless of the size of the report.
+class sc_html_stream : public io::ofstream
+{
+  std::vector<char> buffer;
+
+public:
+  static const size_t BUFFER_SIZE = 4 * 1024 * 1024;
+
+  sc_html_stream();
+  ~sc_html_stream();
+
+  void open( const char* filename, openmode mode = out | trunc );
+  void open( const std::string& filename, openmode mode = out | trunc )
+  { open( filename.c_str(), mode ); }
+};
 
 void generate_player_charts( player_t&,
                              player_processed_report_information_t& );
@@ -218,6 +235,8 @@ std::string decorate_html_string( const std::string& value,
 
 void print_spell_query( std::ostream& out, const sim_t& sim,
                         const spell_data_expr_t&, unsigned level );
+void print_spell_query( xml_node_t* out, const sim_t& sim,
+                        const spell_data_expr_t&, unsigned level );
 void print_spell_query( xml_node_t* out, FILE* file, const sim_t& sim,
                         const spell_data_expr_t&, unsigned level );
 bool check_gear_ilevel( player_t& p, sim_t& sim );
@@ -229,6 +248,7 @@ void print_json( sim_t& );
 void print_html_player( report::sc_html_stream&, player_t&, int );
 void print_xml( sim_t* );
 void print_suite( sim_t* );
+void print_bench( sim_t& );
 std::vector<std::string> beta_warnings();
 std::string pretty_spell_text( const spell_data_t& default_spell,
                                const std::string& text, const player_t& p );
@@ -1788,12 +1788,13 @@ void print_html_player_scale_factors(
 
 bool print_html_sample_sequence_resource(
     const player_t& p,
-    const player_collected_data_t::action_sequence_data_t& data, resource_e r )
+    const action_sequence_t& seq,
+    const action_sequence_t::entry_t& data, resource_e r )
 {
   if ( !p.resources.active_resource[ r ] && !p.sim->maximize_reporting )
     return false;
 
-  if ( data.resource_snapshot[ r ] < 0 )
+  if ( seq.resource( data, r ) < 0 )
     return false;
 
   if ( p.role == ROLE_TANK && r == RESOURCE_HEALTH )
@@ -1807,7 +1808,8 @@ bool print_html_sample_sequence_resource(
 
 void print_html_sample_sequence_string_entry(
     report::sc_html_stream& os,
-    const player_collected_data_t::action_sequence_data_t& data,
+    const action_sequence_t& seq,
+    const action_sequence_t::entry_t& data,
     const player_t& p, bool precombat = false )
 {
   // Skip waiting on the condensed list
@@ -1829,35 +1831,35 @@ void print_html_sample_sequence_string_entry(
 
   resource_e pr = p.primary_resource();
 
-  if ( print_html_sample_sequence_resource( p, data, pr ) )
+  if ( print_html_sample_sequence_resource( p, seq, data, pr ) )
   {
     if ( pr == RESOURCE_HEALTH || pr == RESOURCE_MANA )
-      os.format( " %d%%", (int)( ( data.resource_snapshot[ pr ] /
-                                   data.resource_max_snapshot[ pr ] ) *
+      os.format( " %d%%", (int)( ( seq.resource( data, pr ) /
+                                   seq.resource_max( data, pr ) ) *
                                  100 ) );
     else
-      os.format( " %.1f", data.resource_snapshot[ pr ] );
+      os.format( " %.1f", seq.resource( data, pr ) );
     os.format( " %s |", util::resource_type_string( pr ) );
   }
 
   for ( resource_e r = RESOURCE_HEALTH; r < RESOURCE_MAX; ++r )
   {
-    if ( print_html_sample_sequence_resource( p, data, r ) && r != pr )
+    if ( print_html_sample_sequence_resource( p, seq, data, r ) && r != pr )
     {
       if ( r == RESOURCE_HEALTH || r == RESOURCE_MANA )
-        os.format( " %d%%", (int)( ( data.resource_snapshot[ r ] /
-                                     data.resource_max_snapshot[ r ] ) *
+        os.format( " %d%%", (int)( ( seq.resource( data, r ) /
+                                     seq.resource_max( data, r ) ) *
                                    100 ) );
       else
-        os.format( " %.1f", data.resource_snapshot[ r ] );
+        os.format( " %.1f", seq.resource( data, r ) );
       os.format( " %s |", util::resource_type_string( r ) );
     }
   }
 
-  for ( size_t b = 0; b < data.buff_list.size(); ++b )
+  for ( auto b = seq.buffs_begin( data ); b != seq.buffs_end( data ); ++b )
   {
-    buff_t* buff = data.buff_list[ b ].first;
-    int stacks   = data.buff_list[ b ].second;
+    buff_t* buff = b->buff;
+    int stacks   = b->stacks;
     if ( !buff->constant )
     {
       os.format( "\n%s", buff->name() );
@@ -1872,7 +1874,8 @@ void print_html_sample_sequence_string_entry(
 
 void print_html_sample_sequence_table_entry(
     report::sc_html_stream& os,
-    const player_collected_data_t::action_sequence_data_t& data,
+    const action_sequence_t& seq,
+    const action_sequence_t::entry_t& data,
     const player_t& p, bool precombat = false )
 {
   os << "<tr>\n";
@@ -1912,30 +1915,30 @@ void print_html_sample_sequence_table_entry(
   bool first    = true;
   resource_e pr = p.primary_resource();
 
-  if ( print_html_sample_sequence_resource( p, data, pr ) )
+  if ( print_html_sample_sequence_resource( p, seq, data, pr ) )
   {
     if ( first )
       first = false;
 
-    os.format( " %.1f/%.0f: <b>%.0f%%", data.resource_snapshot[ pr ],
-               data.resource_max_snapshot[ pr ],
-               data.resource_snapshot[ pr ] / data.resource_max_snapshot[ pr ] *
+    os.format( " %.1f/%.0f: <b>%.0f%%", seq.resource( data, pr ),
+               seq.resource_max( data, pr ),
+               seq.resource( data, pr ) / seq.resource_max( data, pr ) *
                    100.0 );
     os.format( " %s</b>", util::resource_type_string( pr ) );
   }
 
   for ( resource_e r = RESOURCE_HEALTH; r < RESOURCE_MAX; ++r )
   {
-    if ( print_html_sample_sequence_resource( p, data, r ) && r != pr )
+    if ( print_html_sample_sequence_resource( p, seq, data, r ) && r != pr )
     {
       if ( first )
         first = false;
       else
         os.format( " | " );
 
-      os.format( " %.1f/%.0f: <b>%.0f%%", data.resource_snapshot[ r ],
-                 data.resource_max_snapshot[ r ],
-                 data.resource_snapshot[ r ] / data.resource_max_snapshot[ r ] *
+      os.format( " %.1f/%.0f: <b>%.0f%%", seq.resource( data, r ),
+                 seq.resource_max( data, r ),
+                 seq.resource( data, r ) / seq.resource_max( data, r ) *
                      100.0 );
       os.format( " %s</b>", util::resource_type_string( r ) );
     }
@@ -1944,10 +1947,10 @@ void print_html_sample_sequence_table_entry(
   os.format( "</td>\n<td class=\"left\">" );
 
   first = true;
-  for ( size_t b = 0; b < data.buff_list.size(); ++b )
+  for ( auto b = seq.buffs_begin( data ); b != seq.buffs_end( data ); ++b )
   {
-    buff_t* buff = data.buff_list[ b ].first;
-    int stacks   = data.buff_list[ b ].second;
+    buff_t* buff = b->buff;
+    int stacks   = b->stacks;
 
     if ( !buff->constant )
     {
@@ -2054,6 +2057,7 @@ void print_html_player_action_priority_list( report::sc_html_stream& os,
 
   if ( !p.collected_data.action_sequence.empty() && !p.is_enemy()  )
   {
+    const action_sequence_t& seq = p.collected_data.action_sequence;
     std::vector<std::string> targets;
 
     targets.push_back( "none" );
@@ -2064,19 +2068,19 @@ void print_html_player_action_priority_list( report::sc_html_stream& os,
 
     for ( const auto& sequence_data : p.collected_data.action_sequence )
     {
-      if ( !sequence_data->action || !sequence_data->action->harmful )
+      if ( sequence_data.precombat || !sequence_data.action || !sequence_data.action->harmful )
         continue;
       bool found = false;
       for ( size_t j = 0; j < targets.size(); ++j )
       {
-        if ( targets[ j ] == sequence_data->target->name() )
+        if ( targets[ j ] == sequence_data.target->name() )
         {
           found = true;
           break;
         }
       }
       if ( !found )
-        targets.push_back( sequence_data->target->name() );
+        targets.push_back( sequence_data.target->name() );
     }
 
     // Sample Sequence (text string)
@@ -2104,15 +2108,16 @@ void print_html_player_action_priority_list( report::sc_html_stream& os,
 
     os << "</style>\n";
 
-    for ( const auto& sequence_data :
-          p.collected_data.action_sequence_precombat )
+    for ( const auto& sequence_data : seq )
     {
-      print_html_sample_sequence_string_entry( os, *sequence_data, p, true );
+      if ( sequence_data.precombat )
+        print_html_sample_sequence_string_entry( os, seq, sequence_data, p, true );
     }
 
-    for ( const auto& sequence_data : p.collected_data.action_sequence )
+    for ( const auto& sequence_data : seq )
     {
-      print_html_sample_sequence_string_entry( os, *sequence_data, p );
+      if ( !sequence_data.precombat )
+        print_html_sample_sequence_string_entry( os, seq, sequence_data, p );
     }
 
     os << "\n</div>\n"
@@ -2137,15 +2142,16 @@ void print_html_player_action_priority_list( report::sc_html_stream& os,
         "<th class=\"center\">buffs</th>\n"
         "</tr>\n" );
 
-    for ( const auto& sequence_data :
-          p.collected_data.action_sequence_precombat )
+    for ( const auto& sequence_data : seq )
     {
-      print_html_sample_sequence_table_entry( os, *sequence_data, p, true );
+      if ( sequence_data.precombat )
+        print_html_sample_sequence_table_entry( os, seq, sequence_data, p, true );
     }
 
-    for ( const auto& sequence_data : p.collected_data.action_sequence )
+    for ( const auto& sequence_data : seq )
     {
-      print_html_sample_sequence_table_entry( os, *sequence_data, p );
+      if ( !sequence_data.precombat )
+        print_html_sample_sequence_table_entry( os, seq, sequence_data, p );
     }
 
     // close table
@@ -1309,12 +1309,12 @@ void print_html_head( report::sc_html_stream& os, const sim_t& sim )
   os << "<meta http-equiv=\"Content-Type\" content=\"text/html; "
         "charset=UTF-8\" />\n";
 
-  os << "<script type=\"text/javascript\">" << std::endl;
+  os << "<script type=\"text/javascript\">\n";
   print_text_array( os, __jquery_include );
-  os << "</script>" << std::endl
-     << "<script type=\"text/javascript\">" << std::endl;
+  os << "</script>\n"
+     << "<script type=\"text/javascript\">\n";
   print_text_array( os, __highcharts_include );
-  os << "</script>" << std::endl;
+  os << "</script>\n";
 
   print_html_style( os, sim );
 
@@ -1453,29 +1453,64 @@ void print_html_( report::sc_html_stream& os, sim_t& sim )
 
   print_html_image_load_scripts( os );
 
+  // Chart series data, shared by every chart series with identical data, and
+  // chart options (referring to their series data by index), shared by every
+  // chart with identical options. Charts get a deep copy of both so Highcharts
+  // can never modify the options or data of another chart.
+  os << "<script type=\"text/javascript\">\n";
+  os << "__chartSeries = [\n";
+  for ( size_t i = 0; i < sim.chart_series.size(); ++i )
+  {
+    os << *sim.chart_series[ i ];
+    if ( i < sim.chart_series.size() - 1 )
+    {
+      os << ",";
+    }
+    os << "\n";
+  }
+  os << "];\n";
+  os << "__chartOptions = [\n";
+  for ( size_t i = 0; i < sim.chart_options.size(); ++i )
+  {
+    os << *sim.chart_options[ i ];
+    if ( i < sim.chart_options.size() - 1 )
+    {
+      os << ",";
+    }
+    os << "\n";
+  }
+  os << "];\n";
+  os << "function __chart(idx) {\n";
+  os << "\tvar o = jQuery.extend(true, {}, __chartOptions[idx]);\n";
+  os << "\tjQuery.each(o.series || [], function(i, s) {\n";
+  os << "\t\tif ( s.__series === undefined ) return;\n";
+  os << "\t\ts.data = jQuery.extend(true, [], __chartSeries[s.__series]);\n";
+  os << "\t\tdelete s.__series;\n";
+  os << "\t});\n";
+  os << "\treturn o;\n";
+  os << "}\n";
+  os << "</script>\n";
+
   os << "<script type=\"text/javascript\">\n";
   os << "jQuery( document ).ready( function( $ ) {\n";
-  for ( size_t i = 0; i < sim.on_ready_chart_data.size(); ++i )
+  for ( const auto& chart : sim.on_ready_chart_data )
   {
-    os << sim.on_ready_chart_data[ i ] << std::endl;
+    os << "$('#" << chart.first << "').highcharts(__chart(" << chart.second << "));\n";
   }
   os << "});\n";
   os << "</script>\n";
   os << "<script type=\"text/javascript\">\n";
   os << "__chartData = {\n";
-  for ( std::map<std::string, std::vector<std::string> >::const_iterator i =
-            sim.chart_data.begin();
-        i != sim.chart_data.end(); ++i )
+  for ( const auto& toggle : sim.chart_data )
   {
-    os << "\"" + i->first + "\": [\n";
-    const std::vector<std::string> data = i->second;
+    os << "\"" << toggle.first << "\": [";
+    const auto& data = toggle.second;
     for ( size_t j = 0; j < data.size(); ++j )
     {
-      os << data[ j ];
+      os << "[\"" << data[ j ].first << "\"," << data[ j ].second << "]";
       if ( j < data.size() - 1 )
       {
-        os << ", ";
-        os << "\n";
+        os << ",";
       }
     }
     os << "],\n";
@@ -1492,7 +1527,7 @@ void print_html_( report::sc_html_stream& os, sim_t& sim )
   os << "\t\t\tvar s = jQuery(this);\n";
   os << "\t\t\tvar d = __chartData[s.attr('id')];\n";
   os << "\t\t\tfor ( idx in d ) {\n";
-  os << "\t\t\t\tjQuery('#' + d[idx]['target']).highcharts(d[idx]['data']);\n";
+  os << "\t\t\t\tjQuery('#' + d[idx][0]).highcharts(__chart(d[idx][1]));\n";
   os << "\t\t\t}\n";
   os << "\t\t});\n";
   os << "\t});\n";
@@ -810,49 +810,57 @@ js::sc_js_t to_json( const player_collected_data_t::buffed_stats_t& bs )
 }
 
 void to_json( JsonOutput root,
-              const std::vector<player_collected_data_t::action_sequence_data_t*>& asd,
+              const action_sequence_t& seq,
+              const action_sequence_t::entry_t* begin,
+              const action_sequence_t::entry_t* end,
+              bool precombat,
               const std::vector<resource_e>& relevant_resources )
 {
   root.make_array();
 
-  range::for_each( asd, [ &root, &relevant_resources ]( const player_collected_data_t::action_sequence_data_t* entry ) {
+  std::for_each( begin, end, [ &root, &seq, precombat, &relevant_resources ]( const action_sequence_t::entry_t& entry ) {
+    if ( entry.precombat != precombat )
+    {
+      return;
+    }
+
     auto json = root.add();
 
-    json[ "time" ] = entry -> time;
-    if ( entry -> action )
+    json[ "time" ] = entry.time;
+    if ( entry.action )
     {
-      json[ "name" ] = entry -> action -> name();
-      json[ "target" ] = entry -> action -> target -> name();
+      json[ "name" ] = entry.action -> name();
+      json[ "target" ] = entry.action -> target -> name();
     }
     else
     {
-      json[ "wait" ] = entry -> wait_time;
+      json[ "wait" ] = entry.wait_time;
     }
 
-    if ( entry -> buff_list.size() > 0 )
+    if ( entry.buff_end > entry.buff_begin )
     {
       auto buffs = json[ "buffs" ];
       buffs.make_array();
-      range::for_each( entry -> buff_list, [ &buffs ]( const std::pair<buff_t*, int> data ) {
+      std::for_each( seq.buffs_begin( entry ), seq.buffs_end( entry ), [ &buffs ]( const action_sequence_t::buff_snapshot_t& data ) {
         auto entry = buffs.add();
 
-        entry[ "name" ] = data.first -> name();
-        entry[ "stacks" ] = data.second;
+        entry[ "name" ] = data.buff -> name();
+        entry[ "stacks" ] = data.stacks;
       } );
     }
 
     auto resources = json[ "resources" ];
     auto resources_max = json[ "resources_max" ];
-    range::for_each( relevant_resources, [ &json, &resources, &resources_max, &entry ]( resource_e r ) {
-      resources[ util::resource_type_string( r ) ] = entry -> resource_snapshot[ r ];
+    range::for_each( relevant_resources, [ &json, &resources, &resources_max, &seq, &entry ]( resource_e r ) {
+      resources[ util::resource_type_string( r ) ] = seq.resource( entry, r );
       // TODO: Why do we have this instead of using some static one?
-      resources_max[ util::resource_type_string( r ) ] = entry -> resource_max_snapshot[ r ];
+      resources_max[ util::resource_type_string( r ) ] = seq.resource_max( entry, r );
     } );
   } );
 }
 
-js::sc_js_t to_json(
-    const player_collected_data_t::action_sequence_data_t& asd )
+js::sc_js_t to_json( const action_sequence_t& seq,
+    const action_sequence_t::entry_t& asd )
 {
   js::sc_js_t node;
   node.set( "time", to_json( asd.time ) );
@@ -865,21 +873,21 @@ js::sc_js_t to_json(
   {
     node.set( "wait_time", to_json( asd.wait_time ) );
   }
-  for ( const auto& buff : asd.buff_list )
+  for ( auto buff = seq.buffs_begin( asd ); buff != seq.buffs_end( asd ); ++buff )
   {
     js::sc_js_t bnode;
-    bnode.set( "name", buff.first->name() );
-    bnode.set( "stacks", buff.second );
+    bnode.set( "name", buff->buff->name() );
+    bnode.set( "stacks", buff->stacks );
     node.add( "buffs", bnode );
   }
 
   js::sc_js_t resource_snapshot;
   for ( resource_e r = RESOURCE_NONE; r < RESOURCE_MAX; ++r )
   {
-    if ( asd.resource_snapshot[ r ] >= 0.0 )
+    if ( seq.resource( asd, r ) >= 0.0 )
     {
       resource_snapshot.set( util::resource_type_string( r ),
-                             asd.resource_snapshot[ r ] );
+                             seq.resource( asd, r ) );
     }
   }
   node.set( "resource_snapshot", resource_snapshot );
@@ -887,10 +895,10 @@ js::sc_js_t to_json(
   js::sc_js_t resource_max_snapshot;
   for ( resource_e r = RESOURCE_NONE; r < RESOURCE_MAX; ++r )
   {
-    if ( asd.resource_max_snapshot[ r ] >= 0.0 )
+    if ( seq.resource_max( asd, r ) >= 0.0 )
     {
       resource_max_snapshot.set( util::resource_type_string( r ),
-                                 asd.resource_max_snapshot[ r ] );
+                                 seq.resource_max( asd, r ) );
     }
   }
   node.set( "resource_max_snapshot", resource_max_snapshot );
@@ -996,14 +1004,31 @@ void collected_data_to_json( JsonOutput root, const player_t& p )
       root[ "health_changes_tmi" ] = cd.health_changes_tmi.merged_timeline;
     }
 
-    if ( ! cd.action_sequence_precombat.empty() )
+    const action_sequence_t& seq = cd.action_sequence;
+    if ( std::any_of( seq.begin(), seq.end(), []( const action_sequence_t::entry_t& e ) { return e.precombat; } ) )
     {
-      to_json( root[ "action_sequence_precombat" ], cd.action_sequence_precombat, relevant_resources );
+      to_json( root[ "action_sequence_precombat" ], seq, seq.begin(), seq.end(), true, relevant_resources );
     }
 
-    if ( ! cd.action_sequence.empty() )
+    if ( std::any_of( seq.begin(), seq.end(), []( const action_sequence_t::entry_t& e ) { return ! e.precombat; } ) )
     {
-      to_json( root[ "action_sequence" ], cd.action_sequence, relevant_resources );
+      to_json( root[ "action_sequence" ], seq, seq.begin(), seq.end(), false, relevant_resources );
+    }
+
+    // Additional iterations chosen with sequence_iterations=
+    if ( seq.iterations.size() > 1 )
+    {
+      auto sequences = root[ "action_sequences" ];
+      sequences.make_array();
+      for ( const auto& it : seq.iterations )
+      {
+        auto node = sequences.add();
+        node[ "iteration" ] = it.iteration;
+        to_json( node[ "action_sequence_precombat" ], seq, seq.entries.data() + it.begin,
+                 seq.entries.data() + it.end, true, relevant_resources );
+        to_json( node[ "action_sequence" ], seq, seq.entries.data() + it.begin,
+                 seq.entries.data() + it.end, false, relevant_resources );
+      }
     }
 
     to_json( root[ "buffed_stats" ], cd.buffed_stats_snapshot, relevant_resources );
@@ -1082,11 +1107,8 @@ js::sc_js_t to_json( const player_collected_data_t& cd, const sim_t& sim )
     node.set( "health_changes", to_json( cd.health_changes_tmi ) );
     for ( const auto& asd : cd.action_sequence )
     {
-      node.add( "action_sequence", to_json( *asd ) );
-    }
-    for ( const auto& asd : cd.action_sequence_precombat )
-    {
-      node.add( "action_sequence_precombat", to_json( *asd ) );
+      node.add( asd.precombat ? "action_sequence_precombat" : "action_sequence",
+                to_json( cd.action_sequence, asd ) );
     }
     node.set( "buffed_stats_snapshot", to_json( cd.buffed_stats_snapshot ) );
   }
@@ -1534,6 +1556,88 @@ void iteration_data_to_json( JsonOutput root, const std::vector<iteration_data_e
   } );
 }
 
+// Phases and threads recorded up to the JSON report, later report writers are missing
+void timing_to_json( JsonOutput root, const phase_timing_t& timing )
+{
+  auto phases = root[ "phases" ].make_array();
+  for ( const auto& p : timing.phases )
+  {
+    auto node = phases.add();
+    node[ "name" ] = p.name;
+    node[ "wall_seconds" ] = p.wall;
+    node[ "cpu_seconds" ] = p.cpu;
+  }
+
+  auto threads = root[ "threads" ].make_array();
+  for ( const auto& t : timing.threads )
+  {
+    auto node = threads.add();
+    node[ "index" ] = t.index;
+    node[ "iterations" ] = t.iterations;
+    node[ "init_seconds" ] = t.init;
+    node[ "run_seconds" ] = t.run;
+    node[ "merge_seconds" ] = t.merge;
+    node[ "idle_seconds" ] = t.idle;
+    node[ "cpu_seconds" ] = t.cpu;
+    node[ "processor" ] = t.processor;
+    node[ "node" ] = t.node;
+    node[ "pinned" ] = t.pinned;
+  }
+}
+
+void comparison_to_json( JsonOutput root, const comparison_t& comparison )
+{
+  root[ "confidence" ] = comparison.confidence;
+  root[ "threshold" ] = comparison.threshold;
+  root[ "iterations" ] = static_cast<unsigned>( comparison.count );
+  root[ "settled_iterations" ] = comparison.settled_iterations;
+
+  auto ranking = root[ "ranking" ].make_array();
+  for ( size_t k = 0; k < comparison.results.size(); ++k )
+  {
+    const auto& r = comparison.results[ k ];
+    auto node = ranking.add();
+    node[ "actor" ] = comparison.actors[ r.actor ] -> name();
+    node[ "mean" ] = r.mean;
+    if ( k + 1 < comparison.results.size() )
+    {
+      node[ "difference" ] = r.difference;
+      node[ "half_width" ] = r.half_width;
+      node[ "verdict" ] = comparison_t::verdict_string( r.verdict );
+    }
+  }
+}
+
+void memory_usage_to_json( JsonOutput root, const memory_report_t::usage_t& usage )
+{
+  for ( size_t i = 0; i < usage.size(); ++i )
+  {
+    root[ memory_report_t::category_string( static_cast<memory_report_t::category_e>( i ) ) ] =
+      static_cast<uint64_t>( usage[ i ] );
+  }
+  root[ "total" ] = static_cast<uint64_t>( memory_report_t::total( usage ) );
+}
+
+// Bytes by actor and category, and by thread before the merge
+void memory_to_json( JsonOutput root, const memory_report_t& memory )
+{
+  auto actors = root[ "actors" ].make_array();
+  for ( const auto& a : memory.actors )
+  {
+    auto node = actors.add();
+    node[ "name" ] = a.name;
+    memory_usage_to_json( node, a.usage );
+  }
+
+  memory_usage_to_json( root[ "sim" ], memory.sim_usage );
+
+  auto threads = root[ "threads" ].make_array();
+  for ( const auto& t : memory.threads )
+    memory_usage_to_json( threads.add(), t );
+
+  root[ "peak_resident_bytes" ] = static_cast<uint64_t>( computer_process::peak_memory_usage() );
+}
+
 void to_json( JsonOutput root, const sim_t& sim )
 {
   // Sim-scope options
@@ -1582,6 +1686,7 @@ void to_json( JsonOutput root, const sim_t& sim )
   options_root[ "pvp_crit" ] = sim.pvp_crit;
   options_root[ "rng" ] = sim.rng();
   options_root[ "deterministic" ] = sim.deterministic;
+  options_root[ "deterministic_iterations" ] = sim.deterministic_iterations;
   options_root[ "average_range" ] = sim.average_range;
   options_root[ "average_gauss" ] = sim.average_gauss;
   options_root[ "fight_style" ] = sim.fight_style;
@@ -1661,6 +1766,15 @@ void to_json( JsonOutput root, const sim_t& sim )
     auto stats_root = root[ "statistics" ];
     stats_root[ "elapsed_cpu_seconds" ] = sim.elapsed_cpu;
     stats_root[ "elapsed_time_seconds" ] = sim.elapsed_time;
+    timing_to_json( stats_root[ "timing" ], *sim.timing );
+    if ( sim.comparison -> enabled() )
+    {
+      comparison_to_json( stats_root[ "comparison" ], *sim.comparison );
+    }
+    if ( sim.memory -> report )
+    {
+      memory_to_json( stats_root[ "memory" ], *sim.memory );
+    }
     stats_root[ "simulation_length" ] = sim.simulation_length;
     add_non_zero( stats_root, "raid_dps", sim.raid_dps );
     add_non_zero( stats_root, "raid_hps", sim.raid_hps );
@@ -1741,6 +1855,7 @@ js::sc_js_t to_json( const sim_t& sim )
   node.set( "rng", to_json( sim.rng() ) );
   node.set( "rng_seed", sim.seed );
   node.set( "deterministic", sim.deterministic );
+  node.set( "deterministic_iterations", sim.deterministic_iterations );
   node.set( "average_range", sim.average_range );
   node.set( "average_gauss", sim.average_gauss );
   for ( const auto& re : sim.raid_events )
@@ -1845,10 +1960,59 @@ void print_json_pretty( FILE* o, const sim_t& sim )
   PrettyWriter<FileWriteStream> writer( b );
   root.js_.Accept( writer );
 }
+// Throughput and resource use of the run, for util_scripts/benchmark.py
+void print_bench_json( FILE* o, const sim_t& sim )
+{
+  Document doc;
+  Value& v = doc;
+  v.SetObject();
+
+  JsonOutput root( doc, v );
+
+  root[ "version" ] = SC_VERSION;
+#if defined( SC_GIT_REV )
+  root[ "git_revision" ] = SC_GIT_REV;
+#endif
+  root[ "iterations" ] = sim.iterations;
+  root[ "threads" ] = sim.threads;
+  root[ "seed" ] = static_cast<uint64_t>( sim.seed );
+  root[ "fight_style" ] = sim.fight_style;
+  root[ "desired_targets" ] = sim.desired_targets;
+  root[ "events" ] = static_cast<uint64_t>( sim.event_mgr.total_events_processed );
+  root[ "elapsed_cpu_seconds" ] = sim.elapsed_cpu;
+  root[ "elapsed_time_seconds" ] = sim.elapsed_time;
+  root[ "events_per_second" ] = sim.elapsed_time > 0 ? sim.event_mgr.total_events_processed / sim.elapsed_time : 0.0;
+  root[ "iterations_per_second" ] = sim.elapsed_time > 0 ? sim.iterations / sim.elapsed_time : 0.0;
+  root[ "init_seconds" ] = sim.timing -> wall( "init" );
+  root[ "merge_seconds" ] = sim.timing -> wall( "merge" );
+  root[ "report_seconds" ] = sim.timing -> wall( "report_" );
+  root[ "peak_rss_bytes" ] = static_cast<uint64_t>( computer_process::peak_memory_usage() );
+
+  std::array<char, 1024> buffer;
+  FileWriteStream b( o, buffer.data(), buffer.size() );
+  PrettyWriter<FileWriteStream> writer( b );
+  doc.Accept( writer );
+}
 }  // unnamed namespace
 
 namespace report
 {
+void print_bench( sim_t& sim )
+{
+  if ( sim.bench_file_str.empty() )
+    return;
+
+  io::cfile s( sim.bench_file_str, "w" );
+  if ( !s )
+  {
+    sim.errorf( "Failed to open benchmark output file '%s'.",
+                sim.bench_file_str.c_str() );
+    return;
+  }
+
+  print_bench_json( s, sim );
+}
+
 void print_json( sim_t& sim )
 {
   if ( ! sim.json_file_str.empty() )
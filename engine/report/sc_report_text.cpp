@@ -762,7 +762,7 @@ void print_text_performance( FILE* file, sim_t* sim )
       "  WallSeconds   = %.3f\n"
       "  SpeedUp       = %.0f\n"
       "  EndTime       = %s (%.0f)\n\n",
-      sim->rng().name(), sim->deterministic ? " (deterministic)" : "",
+      sim->rng().name(), sim->deterministic ? " (deterministic)" : sim->deterministic_iterations ? " (deterministic iterations)" : "",
       sim->iterations, sim->event_mgr.total_events_processed,
       sim->event_mgr.max_events_remaining,
 #ifdef EVENT_QUEUE_DEBUG
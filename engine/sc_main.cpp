@@ -70,6 +70,9 @@ struct sim_signal_handler_t
 
     sa.sa_handler = sigint;
     sigaction( SIGINT,  &sa, nullptr );
+    // Preemptible hosts send SIGTERM, handle it like SIGINT so the run stops
+    // at an iteration boundary (and writes its checkpoint, if enabled)
+    sigaction( SIGTERM, &sa, nullptr );
   }
 
   ~sim_signal_handler_t()
@@ -184,6 +187,8 @@ int sim_t::main( const std::vector<std::string>& args )
 
   sim_control_t control;
 
+  double options_wall = util::wall_time(), options_cpu = util::cpu_time();
+
   try
   {
     control.options.parse_args(args);
@@ -208,6 +213,8 @@ int sim_t::main( const std::vector<std::string>& args )
     setup_success = false;
   }
 
+  timing -> add_phase( "options", util::wall_time() - options_wall, util::cpu_time() - options_cpu );
+
 #if ! defined( SC_GIT_REV )
   util::printf("SimulationCraft %s for World of Warcraft %s %s (wow build %s)\n",
       SC_VERSION, dbc.wow_version(), dbc.wow_ptr_status(), util::to_string(dbc.build_level()).c_str());
@@ -238,12 +245,20 @@ int sim_t::main( const std::vector<std::string>& args )
 
   std::cout << std::endl;
 
-  if ( spell_query )
+  if ( spell_query || ! spell_query_file_str.empty() )
   {
     try
     {
-      spell_query -> evaluate();
-      print_spell_query();
+      // A batch includes the spell_query= query, so both end up in one output
+      if ( ! spell_query_file_str.empty() )
+      {
+        print_spell_query_file();
+      }
+      else
+      {
+        spell_query -> evaluate();
+        print_spell_query();
+      }
     }
     catch( const std::exception& e ){
       std::cerr <<  "ERROR! Spell Query failure: " << e.what() << std::endl;
@@ -264,10 +279,25 @@ int sim_t::main( const std::vector<std::string>& args )
     sim_phase_str = "Generating Baseline:   ";
     if ( execute() )
     {
-      scaling      -> analyze();
-      plot         -> analyze();
-      reforge_plot -> analyze();
-      report::print_suite( this );
+      // Shards are reported by the run merging them
+      if ( ! shard -> enabled() )
+      {
+        {
+          phase_timing_t::scope_t t( *timing, "scaling" );
+          scaling -> analyze();
+        }
+        {
+          phase_timing_t::scope_t t( *timing, "plot" );
+          plot -> analyze();
+          reforge_plot -> analyze();
+        }
+        report::print_suite( this );
+        memory -> finish();
+        report::print_bench( *this );
+        timing -> print();
+        comparison -> print();
+        memory -> print();
+      }
     }
     else
       canceled = 1;
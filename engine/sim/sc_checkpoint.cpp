@@ -0,0 +1,547 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "simulationcraft.hpp"
+
+namespace
+{  // UNNAMED NAMESPACE ==========================================
+
+const uint32_t CHECKPOINT_MAGIC   = 0x4b435353; // "SSCK"
+const uint32_t CHECKPOINT_VERSION = 2;
+
+// The state functions below mirror the merge() methods of the respective
+// types, see util/serialize.hpp for the archive semantics.
+
+template <typename Archive>
+void serialize_state( Archive& ar, gain_t& gain )
+{
+  ar( gain.actual );
+  ar( gain.overflow );
+  ar( gain.count );
+}
+
+template <typename Archive>
+void serialize_state( Archive& ar, proc_t& proc )
+{
+  ar( proc.count );
+  ar( proc.interval_sum );
+}
+
+template <typename Archive>
+void serialize_state( Archive& ar, benefit_t& benefit )
+{ ar( benefit.ratio ); }
+
+template <typename Archive>
+void serialize_state( Archive& ar, uptime_t& uptime )
+{ ar( uptime.uptime_sum ); }
+
+template <typename Archive>
+void serialize_state( Archive& ar, luxurious_sample_data_t& sd )
+{ ar( sd ); }
+
+template <typename Archive>
+void serialize_state( Archive& ar, stats_t::stats_results_t& r )
+{
+  ar( r.count );
+  ar( r.fight_total_amount );
+  ar( r.fight_actual_amount );
+  ar( r.avg_actual_amount );
+  ar( r.actual_amount );
+  ar( r.total_amount );
+  ar( r.overkill_pct );
+}
+
+template <typename Archive>
+void serialize_state( Archive& ar, stats_t& stats )
+{
+  serialize_state( ar, stats.resource_gain );
+  ar( stats.num_direct_results );
+  ar( stats.num_tick_results );
+  ar( stats.num_executes );
+  ar( stats.num_ticks );
+  ar( stats.num_refreshes );
+  ar( stats.total_execute_time );
+  ar( stats.total_tick_time );
+
+  ar( stats.total_amount );
+  ar( stats.actual_amount );
+  ar( stats.portion_aps );
+  ar( stats.portion_apse );
+
+  for ( auto& r : stats.direct_results )
+    serialize_state( ar, r );
+  for ( auto& r : stats.tick_results )
+    serialize_state( ar, r );
+  for ( auto& r : stats.direct_results_detail )
+    serialize_state( ar, r );
+  for ( auto& r : stats.tick_results_detail )
+    serialize_state( ar, r );
+
+  ar( stats.timeline_amount );
+}
+
+template <typename Archive>
+void serialize_state( Archive& ar, buff_t& buff )
+{
+  ar( buff.start_intervals );
+  ar( buff.trigger_intervals );
+
+  ar( buff.uptime_pct );
+  ar( buff.benefit_pct );
+  ar( buff.trigger_pct );
+  ar( buff.avg_start );
+  ar( buff.avg_refresh );
+  ar( buff.avg_expire );
+  ar( buff.avg_overflow_count );
+  ar( buff.avg_overflow_total );
+  if ( buff.sim -> buff_uptime_timeline )
+    ar( buff.uptime_array );
+
+  ar.match( static_cast<uint64_t>( buff.stack_uptime.size() ) );
+  for ( auto& uptime : buff.stack_uptime )
+  {
+    ar( uptime.uptime_sum );
+    if ( buff.sim -> sparse_buff_data )
+      ar( uptime.max_stack_iterations );
+  }
+}
+
+template <typename Archive>
+void serialize_state( Archive& ar, player_collected_data_t& cd )
+{
+  ar( cd.fight_length );
+  ar( cd.waiting_time );
+  ar( cd.executed_foreground_actions );
+  // DMG
+  ar( cd.dmg );
+  ar( cd.compound_dmg );
+  ar( cd.dps );
+  ar( cd.prioritydps );
+  ar( cd.dtps );
+  ar( cd.dpse );
+  ar( cd.dmg_taken );
+  // HEAL
+  ar( cd.heal );
+  ar( cd.compound_heal );
+  ar( cd.hps );
+  ar( cd.htps );
+  ar( cd.hpse );
+  ar( cd.heal_taken );
+  // Tank
+  ar( cd.deaths );
+  ar( cd.timeline_dmg_taken );
+  ar( cd.timeline_healing_taken );
+  ar( cd.theck_meloree_index );
+  ar( cd.effective_theck_meloree_index );
+
+  ar( cd.resource_lost );
+  ar( cd.resource_gained );
+
+  ar.match( static_cast<uint64_t>( cd.resource_timelines.size() ) );
+  for ( auto& rt : cd.resource_timelines )
+  {
+    ar.match( static_cast<int>( rt.type ) );
+    ar( rt.timeline );
+  }
+
+  ar.match( static_cast<uint64_t>( cd.stat_timelines.size() ) );
+  for ( auto& st : cd.stat_timelines )
+  {
+    ar.match( static_cast<int>( st.type ) );
+    ar( st.timeline );
+  }
+
+  ar( cd.health_changes.merged_timeline );
+  ar( cd.health_changes_tmi.merged_timeline );
+}
+
+// Buffs are identified by name and source, like in player_t::merge
+std::string buff_key( const buff_t& b )
+{
+  bool bottom = ! b.source || b.source == b.player;
+  return b.name_str + "/" + util::to_string( bottom ? -1 : b.source -> index );
+}
+
+buff_t* find_buff( const std::vector<buff_t*>& buffs, const std::string& key )
+{
+  auto it = range::find_if( buffs, [ &key ]( const buff_t* b ) { return buff_key( *b ) == key; } );
+  return it != buffs.end() ? *it : nullptr;
+}
+
+std::string actor_key( const player_t& p )
+{ return util::to_string( p.index ) + ":" + p.name_str; }
+
+template <typename Archive>
+void serialize_state( Archive& ar, player_t& p )
+{
+  if ( p.is_pet() )
+  {
+    pet_t* pet = p.cast_pet();
+    if ( pet -> pool )
+    {
+      ar.any( pet -> pool_spawned );
+    }
+  }
+
+  if ( p.minimal_data_collection )
+  {
+    ar( p.collected_data.fight_length );
+    ar( p.collected_data.dmg_taken );
+    ar( p.collected_data.dtps );
+    ar( p.collected_data.heal_taken );
+    ar( p.collected_data.htps );
+    return;
+  }
+
+  serialize_state( ar, p.collected_data );
+
+  ar( p.iteration_resource_lost );
+  ar( p.iteration_resource_gained );
+
+  ar.named( p.buff_list, buff_key,
+            [ &p ]( const std::string& key ) { return find_buff( p.buff_list, key ); },
+            []( Archive& a, buff_t& b ) { serialize_state( a, b ); } );
+
+  ar.named( p.proc_list, []( const proc_t& v ) { return v.name_str; },
+            [ &p ]( const std::string& key ) { return p.find_proc( key ); },
+            []( Archive& a, proc_t& v ) { serialize_state( a, v ); } );
+
+  ar.named( p.gain_list, []( const gain_t& v ) { return v.name_str; },
+            [ &p ]( const std::string& key ) { return p.find_gain( key ); },
+            []( Archive& a, gain_t& v ) { serialize_state( a, v ); } );
+
+  ar.named( p.stats_list, []( const stats_t& v ) { return v.name_str; },
+            [ &p ]( const std::string& key ) { return p.find_stats( key ); },
+            []( Archive& a, stats_t& v ) { serialize_state( a, v ); } );
+
+  ar.named( p.uptime_list, []( const uptime_t& v ) { return v.name_str; },
+            [ &p ]( const std::string& key ) { return p.find_uptime( key ); },
+            []( Archive& a, uptime_t& v ) { serialize_state( a, v ); } );
+
+  ar.named( p.benefit_list, []( const benefit_t& v ) { return v.name_str; },
+            [ &p ]( const std::string& key ) { return p.find_benefit( key ); },
+            []( Archive& a, benefit_t& v ) { serialize_state( a, v ); } );
+
+  ar.named( p.sample_data_list, []( const luxurious_sample_data_t& v ) { return v.name_str; },
+            [ &p ]( const std::string& key ) { return p.find_sample_data( key ); },
+            []( Archive& a, luxurious_sample_data_t& v ) { serialize_state( a, v ); } );
+
+  ar.named( p.action_list, []( const action_t& a ) { return util::to_string( a.internal_id ); },
+            [ &p ]( const std::string& key ) -> action_t* {
+              auto it = range::find_if( p.action_list, [ &key ]( const action_t* a ) {
+                return util::to_string( a -> internal_id ) == key; } );
+              return it != p.action_list.end() ? *it : nullptr;
+            },
+            []( Archive& a, action_t& v ) { a( v.total_executions ); } );
+}
+
+template <typename Archive>
+void serialize_state( Archive& ar, sim_t& sim )
+{
+  ar( sim.simulation_length );
+  ar( sim.total_dmg );
+  ar( sim.raid_dps );
+  ar( sim.total_heal );
+  ar( sim.raid_hps );
+  ar( sim.total_absorb );
+  ar( sim.raid_aps );
+  ar( sim.event_mgr.total_events_processed );
+  ar.max( sim.event_mgr.max_events_remaining );
+
+  ar.named( sim.buff_list, []( const buff_t& b ) { return b.name_str; },
+            [ &sim ]( const std::string& key ) { return buff_t::find( &sim, key ); },
+            []( Archive& a, buff_t& b ) { serialize_state( a, b ); } );
+
+  // Pool members that never spawned carry no data, see sim_t::merge
+  std::vector<player_t*> actors;
+  range::remove_copy_if( sim.actor_list, std::back_inserter( actors ), []( const player_t* p ) {
+    return p -> is_pet() && p -> cast_pet() -> idle_pool_member(); } );
+
+  ar.named( actors, actor_key,
+            [ &sim ]( const std::string& key ) -> player_t* {
+              auto it = range::find_if( sim.actor_list, [ &key ]( const player_t* p ) { return actor_key( *p ) == key; } );
+              return it != sim.actor_list.end() ? *it : nullptr;
+            },
+            []( Archive& a, player_t& p ) { serialize_state( a, p ); } );
+}
+
+}  // UNNAMED NAMESPACE ====================================================
+
+// ==========================================================================
+// Checkpoint
+// ==========================================================================
+
+// checkpoint_t::checkpoint_t ===============================================
+
+checkpoint_t::checkpoint_t( sim_t* s ) :
+  sim( s ),
+  interval( 300.0 ),
+  resume( false ),
+  requested( 0 ),
+  restored( 0 ),
+  generation( 0 ),
+  next_update( -1.0 ),
+  restore_failed( false )
+{
+  create_options();
+}
+
+// checkpoint_t::save_state =================================================
+
+std::string checkpoint_t::save_state( sim_t& s )
+{
+  serialize::writer_t w;
+  serialize_state( w, s );
+  return w.data();
+}
+
+// checkpoint_t::merge_state ================================================
+
+void checkpoint_t::merge_state( sim_t& s, const std::string& state )
+{
+  serialize::reader_t r( state );
+  serialize_state( r, s );
+  if ( ! r.empty() )
+    throw std::runtime_error( "Trailing data in serialized simulation state" );
+
+  // Merging without the data of objects the sim does not have would silently
+  // under-report them
+  if ( ! r.skipped().empty() )
+  {
+    throw std::runtime_error( util::to_string( r.skipped().size() ) +
+                              " serialized objects do not exist in this simulation, first '" +
+                              r.skipped().front() + "'" );
+  }
+}
+
+// checkpoint_t::root =======================================================
+
+/// The top level baseline sim, if this sim (or thread) participates in checkpointing
+sim_t* checkpoint_t::root() const
+{
+  sim_t* r = sim -> thread_root();
+  if ( ! r || r -> parent || r -> checkpoint -> file_str.empty() )
+    return nullptr;
+
+  return r;
+}
+
+// checkpoint_t::seed_offset ================================================
+
+/// Resumed runs must not replay the random streams of the previous run
+uint64_t checkpoint_t::seed_offset() const
+{
+  sim_t* r = root();
+  return r ? static_cast<uint64_t>( r -> checkpoint -> generation ) << 32 : 0;
+}
+
+// checkpoint_t::start ======================================================
+
+bool checkpoint_t::start()
+{
+  if ( file_str.empty() || sim -> parent )
+    return true;
+
+  if ( sim -> deterministic || sim -> deterministic_iterations || sim -> single_actor_batch )
+  {
+    sim -> errorf( "checkpoint_file cannot be used with deterministic=1, deterministic_iterations=1 or single_actor_batch=1, disabling checkpoints.\n" );
+    file_str.clear();
+    return true;
+  }
+
+  requested = sim -> work_queue -> size();
+  thread_state.assign( sim -> threads > 0 ? sim -> threads : 1, std::string() );
+  thread_iterations.assign( thread_state.size(), 0 );
+
+  if ( ! resume )
+    return true;
+
+  io::ifstream in;
+  in.open( file_str, std::ios::in | std::ios::binary );
+  if ( ! in.is_open() )
+  {
+    sim -> errorf( "Unable to open checkpoint file '%s', starting from scratch.\n", file_str.c_str() );
+    return true;
+  }
+
+  std::string data( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+
+  try
+  {
+    serialize::reader_t r( data );
+    r.match( CHECKPOINT_MAGIC );
+    r.match( CHECKPOINT_VERSION );
+    uint64_t saved_seed = r.read<uint64_t>();
+    unsigned saved_generation = r.read<unsigned>();
+    size_t n = static_cast<size_t>( r.read<uint64_t>() );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      restored += r.read<int>();
+      restored_state.push_back( r.read_string() );
+    }
+
+    sim -> seed = saved_seed;
+    generation = saved_generation + 1;
+  }
+  catch ( const std::exception& e )
+  {
+    sim -> errorf( "Invalid checkpoint file '%s': %s\n", file_str.c_str(), e.what() );
+    return false;
+  }
+
+  sim -> work_queue -> skip( restored );
+
+  util::printf( "Resuming from checkpoint '%s' ( iterations=%d, seed=%llu )\n",
+                file_str.c_str(), restored, sim -> seed );
+
+  return true;
+}
+
+// checkpoint_t::restore ====================================================
+
+/// Merge the state loaded by start() into the main sim. Called after the first
+/// iteration, so objects created on first use in combat have a counterpart.
+void checkpoint_t::restore()
+{
+  try
+  {
+    for ( const auto& state : restored_state )
+      merge_state( *sim, state );
+  }
+  catch ( const std::exception& e )
+  {
+    // The state may have been merged partially. Its iterations are not
+    // counted, and the checkpoint file is kept for another attempt.
+    sim -> errorf( "Unable to restore checkpoint '%s': %s\n", file_str.c_str(), e.what() );
+    restored = 0;
+    restore_failed = true;
+    sim -> cancel();
+  }
+
+  restored_state.clear();
+}
+
+// checkpoint_t::iteration_end ==============================================
+
+void checkpoint_t::iteration_end( bool force )
+{
+  sim_t* r = root();
+  if ( ! r )
+    return;
+
+  if ( r == sim && ! restored_state.empty() )
+    restore();
+
+  double now = util::wall_time();
+  if ( next_update < 0 )
+    next_update = now + interval;
+
+  if ( ! force && ( interval <= 0 || now < next_update ) )
+    return;
+
+  next_update = now + interval;
+
+  r -> checkpoint -> update( *sim );
+
+  // The main thread writes the file, including the latest state of every
+  // other thread. The final state is written by finish(), after threads merge.
+  if ( r == sim && ! force )
+    write();
+}
+
+// checkpoint_t::update =====================================================
+
+void checkpoint_t::update( sim_t& thread_sim )
+{
+  std::string state = save_state( thread_sim );
+  int completed = thread_sim.current_iteration + 1 + thread_sim.checkpoint -> restored_iterations();
+
+  AUTO_LOCK( mutex );
+  size_t idx = static_cast<size_t>( thread_sim.thread_index );
+  if ( idx >= thread_state.size() )
+  {
+    thread_state.resize( idx + 1 );
+    thread_iterations.resize( idx + 1 );
+  }
+  thread_state[ idx ].swap( state );
+  thread_iterations[ idx ] = completed;
+}
+
+// checkpoint_t::write ======================================================
+
+void checkpoint_t::write()
+{
+  serialize::writer_t w;
+  w.write( CHECKPOINT_MAGIC );
+  w.write( CHECKPOINT_VERSION );
+  w.write( static_cast<uint64_t>( sim -> seed ) );
+  w.write( generation );
+
+  {
+    AUTO_LOCK( mutex );
+    uint64_t n = std::count_if( thread_state.begin(), thread_state.end(), []( const std::string& s ) { return ! s.empty(); } );
+    w.write( n );
+    for ( size_t i = 0; i < thread_state.size(); ++i )
+    {
+      if ( thread_state[ i ].empty() )
+        continue;
+
+      w.write( thread_iterations[ i ] );
+      w.write_string( thread_state[ i ] );
+    }
+  }
+
+  // Write to a temporary file first, so an interrupted write never destroys
+  // the previous checkpoint
+  std::string tmp_file = file_str + ".tmp";
+  io::ofstream out;
+  out.open( tmp_file, std::ios::out | std::ios::trunc | std::ios::binary );
+  if ( ! out.is_open() )
+  {
+    sim -> errorf( "Unable to open checkpoint file '%s' for writing.\n", tmp_file.c_str() );
+    return;
+  }
+
+  out.write( w.data().data(), w.data().size() );
+  out.close();
+  if ( out.fail() )
+  {
+    sim -> errorf( "Unable to write checkpoint file '%s'.\n", tmp_file.c_str() );
+    return;
+  }
+
+  std::remove( file_str.c_str() );
+  if ( std::rename( tmp_file.c_str(), file_str.c_str() ) != 0 )
+  {
+    sim -> errorf( "Unable to rename checkpoint file '%s' to '%s'.\n", tmp_file.c_str(), file_str.c_str() );
+  }
+}
+
+// checkpoint_t::finish =====================================================
+
+/// Called once all threads have merged. A complete run removes the
+/// checkpoint, an interrupted or canceled one stores its final state.
+void checkpoint_t::finish()
+{
+  if ( file_str.empty() || sim -> parent || restore_failed )
+    return;
+
+  if ( sim -> iterations >= requested && ! sim -> canceled )
+  {
+    std::remove( file_str.c_str() );
+    return;
+  }
+
+  write();
+}
+
+// checkpoint_t::create_options =============================================
+
+void checkpoint_t::create_options()
+{
+  sim -> add_option( opt_string( "checkpoint_file", file_str ) );
+  sim -> add_option( opt_float( "checkpoint_interval", interval ) );
+  sim -> add_option( opt_bool( "checkpoint_resume", resume ) );
+}
@@ -0,0 +1,299 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "simulationcraft.hpp"
+
+// comparison_t::comparison_t ===============================================
+
+comparison_t::comparison_t( sim_t* s ) :
+  sim( s ),
+  confidence( 0 ),
+  threshold( 0.1 ),
+  count( 0 ),
+  checks( 0 ),
+  settled_iterations( 0 )
+{
+  create_options();
+}
+
+// comparison_t::verdict_string ===========================================
+
+const char* comparison_t::verdict_string( verdict_e v )
+{
+  switch ( v )
+  {
+    case RANKED:     return "ranked";
+    case EQUIVALENT: return "equivalent";
+    default:         return "unresolved";
+  }
+}
+
+// comparison_t::init =======================================================
+
+/// Resolve the compared actors, called once the actors of the sim are initialized
+void comparison_t::init()
+{
+  if ( ! enabled() )
+    return;
+
+  std::string error;
+  if ( sim -> single_actor_batch )
+  {
+    error = "comparison_confidence cannot be used with single_actor_batch=1";
+  }
+  else if ( confidence >= 1 )
+  {
+    error = "comparison_confidence must be below 1";
+  }
+  else if ( actors_str.empty() )
+  {
+    for ( auto p : sim -> player_no_pet_list )
+    {
+      if ( ! p -> is_enemy() )
+        actors.push_back( p );
+    }
+  }
+  else
+  {
+    for ( const auto& name : util::string_split( actors_str, "," ) )
+    {
+      player_t* p = sim -> find_player( name );
+      if ( ! p || p -> is_pet() || p -> is_enemy() )
+      {
+        error = "Unknown comparison actor '" + name + "'";
+        break;
+      }
+      actors.push_back( p );
+    }
+  }
+
+  if ( error.empty() && actors.size() < 2 )
+    error = "comparison_confidence requires at least two actors";
+
+  if ( ! error.empty() )
+  {
+    if ( ! sim -> parent )
+      sim -> errorf( "%s, disabling the comparison.\n", error.c_str() );
+    confidence = 0;
+    actors.clear();
+  }
+}
+
+// comparison_t::collect ====================================================
+
+/// Record the target metric of the compared actors at the end of a collected iteration
+void comparison_t::collect()
+{
+  if ( ! enabled() )
+    return;
+
+  std::vector<double> values;
+  values.reserve( actors.size() );
+  for ( auto p : actors )
+    values.push_back( p -> collected_data.iteration_target_metric );
+
+  root() -> add( values );
+}
+
+// comparison_t::root =======================================================
+
+/// Threads of a sim record their iterations in the main thread of the sim
+comparison_t* comparison_t::root() const
+{
+  return sim -> thread_root() -> comparison.get();
+}
+
+// comparison_t::add ========================================================
+
+void comparison_t::add( const std::vector<double>& values )
+{
+  AUTO_LOCK( mutex );
+
+  // Threads may finish an iteration before the main thread is initialized
+  if ( sum.empty() )
+  {
+    sum.assign( values.size(), 0.0 );
+    for ( size_t i = 0; i < values.size(); ++i )
+    {
+      for ( size_t j = i + 1; j < values.size(); ++j )
+        pairs.push_back( pair_t{ i, j, 0.0, 0.0 } );
+    }
+  }
+
+  ++count;
+  for ( size_t i = 0; i < values.size(); ++i )
+    sum[ i ] += values[ i ];
+
+  for ( auto& p : pairs )
+  {
+    double d = values[ p.first ] - values[ p.second ];
+    double delta = d - p.mean;
+    p.mean += delta / count;
+    p.m2 += delta * ( d - p.mean );
+  }
+}
+
+// comparison_t::critical_value =============================================
+
+/// Two sided critical value of the current check. The error probability is
+/// split evenly over the adjacent pairs of the ranking, and over the checks as
+/// 6 / ( pi^2 k^2 ) for the k-th check, which sums to one over all checks.
+double comparison_t::critical_value() const
+{
+  double alpha = ( 1.0 - confidence ) / ( actors.size() - 1 );
+  alpha *= 6.0 / ( M_PI * M_PI * checks * checks );
+
+  return rng::stdnormal_inv( 1.0 - alpha / 2.0 );
+}
+
+// comparison_t::evaluate ===================================================
+
+/// Rank the actors by mean, and decide every adjacent pair. True if all pairs
+/// are decided. Requires the mutex.
+bool comparison_t::evaluate( double z )
+{
+  results.clear();
+  if ( count < 2 )
+    return false;
+
+  std::vector<size_t> order( sum.size() );
+  for ( size_t i = 0; i < order.size(); ++i )
+    order[ i ] = i;
+  range::sort( order, [ this ]( size_t a, size_t b ) { return sum[ a ] > sum[ b ]; } );
+
+  size_t n = sum.size();
+  bool settled = true;
+  for ( size_t k = 0; k < n; ++k )
+  {
+    result_t r{ order[ k ], sum[ order[ k ] ] / count, 0.0, 0.0, RANKED };
+
+    if ( k + 1 < n )
+    {
+      size_t a = std::min( order[ k ], order[ k + 1 ] );
+      size_t b = std::max( order[ k ], order[ k + 1 ] );
+      const pair_t& p = pairs[ a * n - a * ( a + 1 ) / 2 + b - a - 1 ];
+
+      double next_mean = sum[ order[ k + 1 ] ] / count;
+      r.difference = a == order[ k ] ? p.mean : -p.mean;
+      r.half_width = z * std::sqrt( p.m2 / ( count - 1 ) / count );
+
+      double limit = threshold / 100.0 * ( r.mean + next_mean ) / 2.0;
+      if ( std::fabs( r.difference ) > r.half_width )
+        r.verdict = RANKED;
+      else if ( std::fabs( r.difference ) + r.half_width < limit )
+        r.verdict = EQUIVALENT;
+      else
+      {
+        r.verdict = UNRESOLVED;
+        settled = false;
+      }
+    }
+
+    results.push_back( r );
+  }
+
+  return settled;
+}
+
+// comparison_t::analyze ====================================================
+
+/// Periodic check from sim_t::analyze_error, true once the comparison is settled
+bool comparison_t::analyze()
+{
+  AUTO_LOCK( mutex );
+
+  if ( count < 2 )
+    return false;
+
+  ++checks;
+  if ( evaluate( critical_value() ) )
+  {
+    settled_iterations = static_cast<int>( count );
+    return true;
+  }
+
+  // Project the iterations needed to decide the slowest pair, assuming the
+  // differences stay the same and the interval shrinks with 1 / sqrt( n )
+  double ratio = 0;
+  for ( size_t k = 0; k + 1 < results.size(); ++k )
+  {
+    const result_t& r = results[ k ];
+    if ( r.verdict != UNRESOLVED )
+      continue;
+
+    double d = std::fabs( r.difference );
+    double limit = threshold / 100.0 * ( r.mean + results[ k + 1 ].mean ) / 2.0;
+    double pair_ratio = std::numeric_limits<double>::max();
+    if ( d > 0 )
+      pair_ratio = std::min( pair_ratio, ( r.half_width / d ) * ( r.half_width / d ) );
+    if ( limit > d )
+      pair_ratio = std::min( pair_ratio, ( r.half_width / ( limit - d ) ) * ( r.half_width / ( limit - d ) ) );
+
+    ratio = std::max( ratio, pair_ratio );
+  }
+
+  auto progress = sim -> work_queue -> progress();
+  double projected = std::min( progress.current_iterations * ratio, static_cast<double>( sim -> work_queue -> size() ) );
+  if ( projected > progress.current_iterations )
+    sim -> work_queue -> project( static_cast<int>( projected ) );
+
+  return false;
+}
+
+// comparison_t::finish =====================================================
+
+/// Final ranking over all collected iterations, called when the sim is analyzed
+void comparison_t::finish()
+{
+  if ( ! enabled() || sim -> thread_index > 0 )
+    return;
+
+  AUTO_LOCK( mutex );
+
+  if ( checks == 0 )
+    checks = 1;
+
+  evaluate( critical_value() );
+}
+
+// comparison_t::print ======================================================
+
+void comparison_t::print() const
+{
+  if ( ! enabled() || sim -> parent )
+    return;
+
+  // The final ranking may also settle without stopping the sim early
+  bool settled = ! results.empty() &&
+    range::find_if( results, []( const result_t& r ) { return r.verdict == UNRESOLVED; } ) == results.end();
+
+  util::printf( "\nComparison ( confidence=%.1f%%, threshold=%.2f%% ): %s after %d iterations\n",
+                confidence * 100.0, threshold, settled ? "settled" : "not settled",
+                settled_iterations > 0 ? settled_iterations : static_cast<int>( count ) );
+
+  util::printf( "  %-4s %-24s %12s %26s  %s\n", "rank", "actor", "mean", "difference to next", "verdict" );
+  for ( size_t k = 0; k < results.size(); ++k )
+  {
+    const result_t& r = results[ k ];
+    if ( k + 1 < results.size() )
+    {
+      util::printf( "  %-4u %-24s %12.1f %12.1f +/- %9.1f  %s\n", static_cast<unsigned>( k + 1 ),
+                    actors[ r.actor ] -> name(), r.mean, r.difference, r.half_width, verdict_string( r.verdict ) );
+    }
+    else
+    {
+      util::printf( "  %-4u %-24s %12.1f\n", static_cast<unsigned>( k + 1 ), actors[ r.actor ] -> name(), r.mean );
+    }
+  }
+}
+
+// comparison_t::create_options =============================================
+
+void comparison_t::create_options()
+{
+  sim -> add_option( opt_float( "comparison_confidence", confidence ) );
+  sim -> add_option( opt_float( "comparison_threshold", threshold ) );
+  sim -> add_option( opt_string( "comparison_actors", actors_str ) );
+}
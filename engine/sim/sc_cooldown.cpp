@@ -126,7 +126,9 @@ cooldown_t::cooldown_t( const std::string& n, player_t& p ) :
   last_charged( timespan_t::zero() ),
   recharge_multiplier( 1.0 ),
   hasted( false ),
-  action( nullptr )
+  action( nullptr ),
+  dynamic_index( -1 ),
+  dynamic_running( false )
 {}
 
 cooldown_t::cooldown_t( const std::string& n, sim_t& s ) :
@@ -144,7 +146,9 @@ cooldown_t::cooldown_t( const std::string& n, sim_t& s ) :
   last_charged( timespan_t::zero() ),
   recharge_multiplier( 1.0 ),
   hasted( false ),
-  action( nullptr )
+  action( nullptr ),
+  dynamic_index( -1 ),
+  dynamic_running( false )
 {}
 
 // Adjust a dynamic cooldown (reduction) multiplier based on the current action associated with the
@@ -290,6 +294,8 @@ void cooldown_t::reset_init()
 
   recharge_event = nullptr;
   ready_trigger_event = nullptr;
+
+  dynamic_running = false;
 }
 
 void cooldown_t::reset( bool require_reaction, bool all_charges )
@@ -384,6 +390,9 @@ void cooldown_t::start( action_t* a, timespan_t _override, timespan_t delay )
   }
 
   assert( player );
+  if ( dynamic_index >= 0 && ! dynamic_running && down() )
+    player -> add_running_dynamic_cooldown( this );
+
   if ( player -> ready_type == READY_TRIGGER )
     ready_trigger_event = make_event<ready_trigger_event_t>( sim, *player, this );
 }
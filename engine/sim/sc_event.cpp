@@ -182,26 +182,45 @@ void event_manager_t::recycle_event( event_t* e )
   recycled_event_list = e;
 }
 
-// event_manager_t::add_event ===============================================
+// event_manager_t::assign_event_time =======================================
 
-void event_manager_t::add_event( event_t* e, timespan_t delta_time )
+// Assign the id and timing wheel time of an event scheduled delta_time from now.
+unsigned event_manager_t::assign_event_time( timespan_t delta_time, timespan_t& time,
+                                             timespan_t& reschedule_time )
 {
-  e->id = ++global_event_id;
-
   if ( delta_time < timespan_t::zero() )
     delta_time = timespan_t::zero();
 
   if ( delta_time > wheel_time )
   {
-    e->time = current_time + wheel_time - timespan_t::from_seconds( 1 );
-    e->reschedule_time = current_time + delta_time;
+    time            = current_time + wheel_time - timespan_t::from_seconds( 1 );
+    reschedule_time = current_time + delta_time;
   }
   else
   {
-    e->time            = current_time + delta_time;
-    e->reschedule_time = timespan_t::zero();
+    time            = current_time + delta_time;
+    reschedule_time = timespan_t::zero();
   }
 
+  return ++global_event_id;
+}
+
+// event_manager_t::add_event ===============================================
+
+void event_manager_t::add_event( event_t* e, timespan_t delta_time )
+{
+  e->id = assign_event_time( delta_time, e->time, e->reschedule_time );
+
+  insert_event( e );
+}
+
+// event_manager_t::insert_event ============================================
+
+// Insert an event with its time and id already assigned. Events are ordered by
+// time, and by id for equal times, so an event executes in the same order
+// regardless of when it is inserted.
+void event_manager_t::insert_event( event_t* e )
+{
   // Determine the timing wheel position to which the event will belong
   // Only valid for integer based timespan_t
   uint32_t slice = static_cast<uint32_t>(
@@ -214,7 +233,9 @@ void event_manager_t::add_event( event_t* e, timespan_t delta_time )
 #endif
 
   while ( ( *prev ) &&
-          ( *prev )->time <= e->time )  // Find position in the list
+          ( ( *prev )->time < e->time ||
+            ( ( *prev )->time == e->time &&
+              ( *prev )->id < e->id ) ) )  // Find position in the list
   {
     prev = &( ( *prev )->next );
 #ifdef EVENT_QUEUE_DEBUG
@@ -13,6 +13,81 @@ namespace
 {  // ANONYMOUS ====================================================
 
 const bool EXPRESSION_DEBUG = false;
+
+// Static evaluation of logical operators. Unlike optimize(), these do not
+// modify the expression tree, and short-circuit on a constant false (and) or
+// true (or) operand even if the other operand is not constant.
+
+bool constant_and( expr_t* left, expr_t* right, double* v )
+{
+  double l, r;
+  bool left_constant  = left->is_constant( &l );
+  bool right_constant = right->is_constant( &r );
+  if ( ( left_constant && l == 0 ) || ( right_constant && r == 0 ) )
+  {
+    *v = 0;
+    return true;
+  }
+  if ( left_constant && right_constant )
+  {
+    *v = 1;
+    return true;
+  }
+  return false;
+}
+
+bool constant_or( expr_t* left, expr_t* right, double* v )
+{
+  double l, r;
+  bool left_constant  = left->is_constant( &l );
+  bool right_constant = right->is_constant( &r );
+  if ( ( left_constant && l != 0 ) || ( right_constant && r != 0 ) )
+  {
+    *v = 1;
+    return true;
+  }
+  if ( left_constant && right_constant )
+  {
+    *v = 0;
+    return true;
+  }
+  return false;
+}
+
+bool constant_xor( expr_t* left, expr_t* right, double* v )
+{
+  double l, r;
+  if ( left->is_constant( &l ) && right->is_constant( &r ) )
+  {
+    *v = bool( l != 0 ) != bool( r != 0 );
+    return true;
+  }
+  return false;
+}
+
+template <typename F>
+bool constant_unary( expr_t* input, double* v )
+{
+  double i;
+  if ( input->is_constant( &i ) )
+  {
+    *v = F()( i );
+    return true;
+  }
+  return false;
+}
+
+template <typename F>
+bool constant_binary( expr_t* left, expr_t* right, double* v )
+{
+  double l, r;
+  if ( left->is_constant( &l ) && right->is_constant( &r ) )
+  {
+    *v = F()( l, r );
+    return true;
+  }
+  return false;
+}
 // Unary Operators ==========================================================
 
 template <class F>
@@ -36,6 +111,11 @@ public:
   {
     return F()( input->eval() );
   }
+
+  bool is_constant( double* v ) override  // override
+  {
+    return constant_unary<F>( input, v );
+  }
 };
 
 namespace unary
@@ -120,6 +200,11 @@ public:
   {
     return left->eval() && right->eval();
   }
+
+  bool is_constant( double* v ) override  // override
+  {
+    return constant_and( left, right, v );
+  }
 };
 
 class logical_or_t : public binary_base_t
@@ -134,6 +219,11 @@ public:
   {
     return left->eval() || right->eval();
   }
+
+  bool is_constant( double* v ) override  // override
+  {
+    return constant_or( left, right, v );
+  }
 };
 
 class logical_xor_t : public binary_base_t
@@ -148,6 +238,11 @@ public:
   {
     return bool( left->eval() != 0 ) != bool( right->eval() != 0 );
   }
+
+  bool is_constant( double* v ) override  // override
+  {
+    return constant_xor( left, right, v );
+  }
 };
 
 template <template <typename> class F>
@@ -163,6 +258,11 @@ public:
   {
     return F<double>()( left->eval(), right->eval() );
   }
+
+  bool is_constant( double* v ) override  // override
+  {
+    return constant_binary<F<double>>( left, right, v );
+  }
 };
 
 expr_t* select_binary( const std::string& name, token_e op, expr_t* left,
@@ -228,6 +328,11 @@ public:
     return F()( input->eval() );
   }
 
+  bool is_constant( double* v ) override  // override
+  {
+    return constant_unary<F>( input, v );
+  }
+
   expr_t* optimize( int spacing ) override  // override
   {
     if ( EXPRESSION_DEBUG )
@@ -342,6 +447,11 @@ public:
     return result;
   }
 
+  bool is_constant( double* v ) override  // override
+  {
+    return constant_and( left, right, v );
+  }
+
   expr_t* optimize( int spacing ) override  // override
   {
     if ( EXPRESSION_DEBUG )
@@ -463,6 +573,11 @@ public:
     return result;
   }
 
+  bool is_constant( double* v ) override  // override
+  {
+    return constant_or( left, right, v );
+  }
+
   expr_t* optimize( int spacing ) override  // override
   {
     if ( EXPRESSION_DEBUG )
@@ -575,6 +690,11 @@ public:
     return result;
   }
 
+  bool is_constant( double* v ) override  // override
+  {
+    return constant_xor( left, right, v );
+  }
+
   expr_t* optimize( int spacing ) override  // override
   {
     if ( EXPRESSION_DEBUG )
@@ -669,6 +789,11 @@ public:
     return result;
   }
 
+  bool is_constant( double* v ) override  // override
+  {
+    return constant_binary<F<double>>( left, right, v );
+  }
+
   expr_t* optimize( int spacing ) override  // override
   {
     if ( EXPRESSION_DEBUG )
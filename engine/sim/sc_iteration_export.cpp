@@ -0,0 +1,253 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "simulationcraft.hpp"
+
+namespace
+{  // UNNAMED NAMESPACE ==========================================
+
+const uint32_t CHUNK_MAGIC   = 0x43495353; // "SSIC"
+const uint32_t CHUNK_VERSION = 1;
+
+// Rows buffered per thread before a chunk is written, bounds memory use
+const size_t CHUNK_ROWS = 4096;
+
+enum column_encoding_e
+{
+  ENCODING_F64 = 0,
+  ENCODING_U32 = 1
+};
+
+double player_dps( const player_t& p )
+{
+  double f_length = p.iteration_fight_length.total_seconds();
+  if ( f_length == 0 )
+    return 0;
+
+  double dmg = p.iteration_dmg;
+  for ( const auto pet : p.pet_list )
+    dmg += pet -> iteration_dmg;
+
+  return dmg / f_length;
+}
+
+}  // UNNAMED NAMESPACE ====================================================
+
+// ==========================================================================
+// Iteration Data Export
+// ==========================================================================
+
+// iteration_export_t::iteration_export_t ===================================
+
+iteration_export_t::iteration_export_t( sim_t* s ) :
+  sim( s ),
+  active( false ),
+  rows( 0 )
+{
+  create_options();
+}
+
+// iteration_export_t::part_file ============================================
+
+std::string iteration_export_t::part_file( int thread_index ) const
+{
+  return file_str + "." + util::to_string( thread_index );
+}
+
+// iteration_export_t::start ================================================
+
+/// Open the part file of this thread, called after the sim is initialized
+void iteration_export_t::start()
+{
+  // Only the baseline sim and its threads export
+  const sim_t* baseline = sim -> thread_root();
+  active = ! file_str.empty() && baseline && ! baseline -> parent;
+  if ( ! active )
+    return;
+
+  out.open( part_file( sim -> thread_index ), std::ios::out | std::ios::trunc | std::ios::binary );
+  if ( ! out.is_open() )
+  {
+    sim -> errorf( "Unable to open iteration data file '%s'.\n", part_file( sim -> thread_index ).c_str() );
+    active = false;
+    return;
+  }
+
+  build_columns();
+}
+
+// iteration_export_t::build_columns ========================================
+
+/// Column layout of the next chunk. Rebuilt per chunk, so stats objects
+/// created during the simulation show up from the following chunk on.
+void iteration_export_t::build_columns()
+{
+  columns.clear();
+
+  columns.push_back( column_t{ "iteration", COLUMN_ITERATION, nullptr, nullptr, 0, {} } );
+  columns.push_back( column_t{ "fight_length", COLUMN_FIGHT_LENGTH, nullptr, nullptr, 0, {} } );
+  columns.push_back( column_t{ "raid_dps", COLUMN_RAID_DPS, nullptr, nullptr, 0, {} } );
+
+  for ( const auto p : sim -> player_no_pet_list )
+  {
+    columns.push_back( column_t{ p -> name_str + ".dps", COLUMN_PLAYER_DPS, p, nullptr, 0, {} } );
+    columns.push_back( column_t{ p -> name_str + ".deaths", COLUMN_PLAYER_DEATHS, p, nullptr,
+                                 p -> collected_data.deaths.count(), {} } );
+
+    for ( const auto s : p -> stats_list )
+    {
+      columns.push_back( column_t{ p -> name_str + "/" + s -> name_str, COLUMN_ACTION_AMOUNT, p, s, 0, {} } );
+    }
+
+    for ( const auto pet : p -> pet_list )
+    {
+      for ( const auto s : pet -> stats_list )
+      {
+        columns.push_back( column_t{ p -> name_str + "/" + pet -> name_str + "/" + s -> name_str,
+                                     COLUMN_ACTION_AMOUNT, pet, s, 0, {} } );
+      }
+    }
+  }
+
+  for ( auto& c : columns )
+    c.values.reserve( CHUNK_ROWS );
+}
+
+// iteration_export_t::add_row ==============================================
+
+/// Record the iteration that just finished, called from sim_t::datacollection_end
+void iteration_export_t::add_row()
+{
+  if ( ! active )
+    return;
+
+  double length = sim -> current_time().total_seconds();
+
+  for ( auto& c : columns )
+  {
+    double v = 0;
+    switch ( c.type )
+    {
+      case COLUMN_ITERATION:
+        v = sim -> current_iteration;
+        break;
+      case COLUMN_FIGHT_LENGTH:
+        v = length;
+        break;
+      case COLUMN_RAID_DPS:
+        v = length ? sim -> iteration_dmg / length : 0;
+        break;
+      case COLUMN_PLAYER_DPS:
+        v = player_dps( *c.player );
+        break;
+      case COLUMN_PLAYER_DEATHS:
+      {
+        size_t deaths = c.player -> collected_data.deaths.count();
+        v = static_cast<double>( deaths - c.last_count );
+        c.last_count = deaths;
+        break;
+      }
+      case COLUMN_ACTION_AMOUNT:
+        v = c.stats -> iteration_actual_amount;
+        break;
+    }
+    c.values.push_back( v );
+  }
+
+  if ( ++rows == CHUNK_ROWS )
+  {
+    write_chunk();
+    build_columns();
+  }
+}
+
+// iteration_export_t::write_chunk ==========================================
+
+void iteration_export_t::write_chunk()
+{
+  if ( rows == 0 )
+    return;
+
+  serialize::writer_t w;
+  w.write( CHUNK_MAGIC );
+  w.write( CHUNK_VERSION );
+  w.write( static_cast<uint32_t>( sim -> thread_index ) );
+  w.write( static_cast<uint32_t>( rows ) );
+  w.write( static_cast<uint32_t>( columns.size() ) );
+
+  for ( const auto& c : columns )
+  {
+    w.write_string( c.name );
+
+    if ( c.type == COLUMN_ITERATION || c.type == COLUMN_PLAYER_DEATHS )
+    {
+      w.write( static_cast<uint8_t>( ENCODING_U32 ) );
+      for ( double v : c.values )
+        w.write( static_cast<uint32_t>( v ) );
+    }
+    else
+    {
+      w.write( static_cast<uint8_t>( ENCODING_F64 ) );
+      for ( double v : c.values )
+        w.write( v );
+    }
+  }
+
+  out.write( w.data().data(), w.data().size() );
+  rows = 0;
+}
+
+// iteration_export_t::finish_thread ========================================
+
+/// Write the last (partial) chunk, called at the end of sim_t::iterate
+void iteration_export_t::finish_thread()
+{
+  if ( ! active )
+    return;
+
+  write_chunk();
+  out.close();
+  if ( out.fail() )
+  {
+    sim -> errorf( "Unable to write iteration data file '%s'.\n", part_file( sim -> thread_index ).c_str() );
+  }
+}
+
+// iteration_export_t::finish ===============================================
+
+/// Concatenate the part files of all threads, called once all threads have merged
+void iteration_export_t::finish()
+{
+  if ( ! active || sim -> parent )
+    return;
+
+  io::ofstream file;
+  file.open( file_str, std::ios::out | std::ios::trunc | std::ios::binary );
+  if ( ! file.is_open() )
+  {
+    sim -> errorf( "Unable to open iteration data file '%s'.\n", file_str.c_str() );
+    return;
+  }
+
+  for ( int i = 0; i < std::max( sim -> threads, 1 ); ++i )
+  {
+    io::ifstream part;
+    part.open( part_file( i ), std::ios::in | std::ios::binary );
+    if ( ! part.is_open() )
+      continue;
+
+    if ( part.peek() != std::char_traits<char>::eof() )
+      file << part.rdbuf();
+    part.close();
+    std::remove( part_file( i ).c_str() );
+  }
+}
+
+// iteration_export_t::create_options =======================================
+
+void iteration_export_t::create_options()
+{
+  sim -> add_option( opt_string( "iteration_data_file", file_str ) );
+}
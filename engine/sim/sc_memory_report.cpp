@@ -0,0 +1,304 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "simulationcraft.hpp"
+
+namespace
+{  // UNNAMED NAMESPACE ==========================================
+
+template <typename T>
+size_t vector_bytes( const std::vector<T>& v )
+{ return v.capacity() * sizeof( T ); }
+
+size_t sample_bytes( const extended_sample_data_t& d )
+{ return vector_bytes( d.data() ) + vector_bytes( d.sorted_data() ) + vector_bytes( d.distribution ); }
+
+size_t timeline_bytes( const timeline_t& t )
+{ return vector_bytes( t.data() ); }
+
+size_t health_timeline_bytes( const player_collected_data_t::health_changes_timeline_t& t )
+{ return timeline_bytes( t.timeline ) + timeline_bytes( t.timeline_normalized ) + timeline_bytes( t.merged_timeline ); }
+
+double megabytes( size_t bytes )
+{ return bytes / ( 1024.0 * 1024.0 ); }
+
+void print_usage( const std::string& label, const memory_report_t::usage_t& usage )
+{
+  util::printf( "  %-24s", label.c_str() );
+  for ( auto bytes : usage )
+    util::printf( " %9.2f", megabytes( bytes ) );
+  util::printf( " %9.2f\n", megabytes( memory_report_t::total( usage ) ) );
+}
+
+void print_header( const char* label )
+{
+  util::printf( "  %-24s", label );
+  for ( int i = 0; i < memory_report_t::MEMORY_MAX; ++i )
+    util::printf( " %9s", memory_report_t::category_string( static_cast<memory_report_t::category_e>( i ) ) );
+  util::printf( " %9s\n", "total" );
+}
+
+}  // UNNAMED NAMESPACE ==========================================
+
+// memory_report_t::memory_report_t =========================================
+
+memory_report_t::memory_report_t( sim_t* s ) :
+  sim( s ),
+  report( false ),
+  interval( 0 ),
+  sim_usage()
+{
+  create_options();
+}
+
+// memory_report_t::category_string ========================================
+
+const char* memory_report_t::category_string( category_e c )
+{
+  switch ( c )
+  {
+    case MEMORY_SAMPLES:   return "samples";
+    case MEMORY_TIMELINES: return "timelines";
+    case MEMORY_BUFFS:     return "buffs";
+    case MEMORY_SEQUENCES: return "sequences";
+    case MEMORY_STATES:    return "states";
+    case MEMORY_EVENTS:    return "events";
+    case MEMORY_REPORTS:   return "reports";
+    default:               return "unknown";
+  }
+}
+
+// memory_report_t::total ===================================================
+
+size_t memory_report_t::total( const usage_t& usage )
+{
+  size_t bytes = 0;
+  for ( auto b : usage )
+    bytes += b;
+
+  return bytes;
+}
+
+// memory_report_t::account_actor ===========================================
+
+void memory_report_t::account_actor( const player_t& p, usage_t& usage ) const
+{
+  const player_collected_data_t& cd = p.collected_data;
+
+  for ( const extended_sample_data_t* d : { &cd.fight_length, &cd.waiting_time, &cd.pooling_time,
+          &cd.executed_foreground_actions, &cd.dmg, &cd.compound_dmg, &cd.prioritydps, &cd.dps, &cd.dpse,
+          &cd.dtps, &cd.dmg_taken, &cd.heal, &cd.compound_heal, &cd.hps, &cd.hpse, &cd.htps, &cd.heal_taken,
+          &cd.absorb, &cd.compound_absorb, &cd.aps, &cd.atps, &cd.absorb_taken, &cd.deaths,
+          &cd.theck_meloree_index, &cd.effective_theck_meloree_index, &cd.max_spike_amount, &cd.target_metric } )
+  {
+    usage[ MEMORY_SAMPLES ] += sample_bytes( *d );
+  }
+  usage[ MEMORY_SAMPLES ] += vector_bytes( cd.combat_end_resource );
+
+  usage[ MEMORY_TIMELINES ] += timeline_bytes( cd.timeline_dmg ) + timeline_bytes( cd.timeline_dmg_taken ) +
+                               timeline_bytes( cd.timeline_healing_taken );
+  usage[ MEMORY_TIMELINES ] += vector_bytes( cd.resource_timelines ) + vector_bytes( cd.stat_timelines );
+  for ( const auto& t : cd.resource_timelines )
+    usage[ MEMORY_TIMELINES ] += timeline_bytes( t.timeline );
+  for ( const auto& t : cd.stat_timelines )
+    usage[ MEMORY_TIMELINES ] += timeline_bytes( t.timeline );
+  usage[ MEMORY_TIMELINES ] += health_timeline_bytes( cd.health_changes ) + health_timeline_bytes( cd.health_changes_tmi );
+
+  const action_sequence_t& sequence = cd.action_sequence;
+  usage[ MEMORY_SEQUENCES ] += vector_bytes( sequence.entries ) + vector_bytes( sequence.buffs ) +
+                               vector_bytes( sequence.resources ) + vector_bytes( sequence.iterations );
+
+  for ( const stats_t* s : p.stats_list )
+  {
+    usage[ MEMORY_SAMPLES ] += sample_bytes( s -> actual_amount ) + sample_bytes( s -> total_amount ) +
+                               sample_bytes( s -> portion_aps ) + sample_bytes( s -> portion_apse );
+    usage[ MEMORY_TIMELINES ] += timeline_bytes( s -> timeline_amount );
+    usage[ MEMORY_REPORTS ] += s -> timeline_aps_chart.capacity();
+  }
+
+  for ( const buff_t* b : p.buff_list )
+  {
+    usage[ MEMORY_BUFFS ] += timeline_bytes( b -> uptime_array ) + vector_bytes( b -> stack_uptime ) +
+                             vector_bytes( b -> stack_occurrence ) + vector_bytes( b -> stack_react_time );
+  }
+
+  // States in flight are not cached, counted at their base size
+  for ( const action_t* a : p.action_list )
+  {
+    for ( const action_state_t* s = a -> state_cache; s; s = s -> next )
+      usage[ MEMORY_STATES ] += sizeof( action_state_t );
+  }
+
+  const player_processed_report_information_t& info = p.report_information;
+  for ( const std::string* str : { &info.save_str, &info.save_gear_str, &info.save_talents_str,
+          &info.save_actions_str, &info.comment_str, &info.thumbnail_url, &info.html_profile_str } )
+  {
+    usage[ MEMORY_REPORTS ] += str -> capacity();
+  }
+}
+
+// memory_report_t::account_sim =============================================
+
+/// Data of the sim that is not attributed to an actor
+void memory_report_t::account_sim( usage_t& usage ) const
+{
+  usage[ MEMORY_SAMPLES ] += sample_bytes( sim -> simulation_length );
+
+  for ( const buff_t* b : sim -> buff_list )
+  {
+    usage[ MEMORY_BUFFS ] += timeline_bytes( b -> uptime_array ) + vector_bytes( b -> stack_uptime ) +
+                             vector_bytes( b -> stack_occurrence ) + vector_bytes( b -> stack_react_time );
+  }
+
+  // Event memory is allocated in blocks of twice the size of event_t, see event_manager_t::allocate_event
+  const event_manager_t& events = sim -> event_mgr;
+  usage[ MEMORY_EVENTS ] += events.allocated_events.size() * 2 * sizeof( event_t ) +
+                            vector_bytes( events.allocated_events ) + vector_bytes( events.timing_wheel );
+
+  usage[ MEMORY_REPORTS ] += vector_bytes( sim -> iteration_data ) + vector_bytes( sim -> low_iteration_data ) +
+                             vector_bytes( sim -> high_iteration_data );
+}
+
+// memory_report_t::account_thread ==========================================
+
+memory_report_t::usage_t memory_report_t::account_thread() const
+{
+  usage_t usage = usage_t();
+  for ( const player_t* p : sim -> actor_list )
+    account_actor( *p, usage );
+  account_sim( usage );
+
+  return usage;
+}
+
+// memory_report_t::root ====================================================
+
+memory_report_t* memory_report_t::root() const
+{
+  return sim -> thread_root() -> memory.get();
+}
+
+// memory_report_t::add_thread ==============================================
+
+void memory_report_t::add_thread( int thread_index, const usage_t& usage )
+{
+  AUTO_LOCK( mutex );
+
+  if ( threads.size() <= static_cast<size_t>( thread_index ) )
+    threads.resize( thread_index + 1 );
+  threads[ thread_index ] = usage;
+}
+
+// memory_report_t::iteration_end ===========================================
+
+/// Periodic accounting with report_memory_interval, every thread accounts its
+/// own data and the main thread prints the total of the latest accountings
+void memory_report_t::iteration_end()
+{
+  if ( interval <= 0 || sim -> current_iteration < 0 || ( sim -> current_iteration + 1 ) % interval != 0 )
+    return;
+
+  root() -> add_thread( sim -> thread_index, account_thread() );
+
+  if ( sim -> thread_index > 0 || sim -> parent )
+    return;
+
+  usage_t usage = usage_t();
+  size_t n_threads;
+  {
+    AUTO_LOCK( mutex );
+    for ( const auto& t : threads )
+    {
+      for ( size_t i = 0; i < usage.size(); ++i )
+        usage[ i ] += t[ i ];
+    }
+    n_threads = threads.size();
+  }
+
+  util::printf( "\nMemory at iteration %d: %.1f MB over %u threads (", sim -> current_iteration + 1,
+                megabytes( total( usage ) ), static_cast<unsigned>( n_threads ) );
+  for ( size_t i = 0; i < usage.size(); ++i )
+    util::printf( " %s=%.1f", category_string( static_cast<category_e>( i ) ), megabytes( usage[ i ] ) );
+  util::printf( " ), peak resident %.1f MB\n", megabytes( computer_process::peak_memory_usage() ) );
+}
+
+// memory_report_t::finish_thread ===========================================
+
+/// Accounting of a thread when it runs out of work, before it is merged
+void memory_report_t::finish_thread()
+{
+  if ( ! report )
+    return;
+
+  root() -> add_thread( sim -> thread_index, account_thread() );
+}
+
+// memory_report_t::finish ==================================================
+
+/// Accounting of the merged sim, called after the reports are written
+void memory_report_t::finish()
+{
+  if ( ! report || sim -> thread_index > 0 )
+    return;
+
+  actors.clear();
+  for ( const player_t* p : sim -> actor_list )
+  {
+    if ( p -> is_pet() )
+      continue;
+
+    actor_t actor{ p -> name_str, usage_t() };
+    account_actor( *p, actor.usage );
+    for ( const pet_t* pet : p -> pet_list )
+      account_actor( *pet, actor.usage );
+
+    actors.push_back( actor );
+  }
+
+  range::sort( actors, []( const actor_t& a, const actor_t& b ) { return total( a.usage ) > total( b.usage ); } );
+
+  sim_usage = usage_t();
+  account_sim( sim_usage );
+}
+
+// memory_report_t::print ===================================================
+
+void memory_report_t::print() const
+{
+  if ( ! report || sim -> parent )
+    return;
+
+  usage_t usage = sim_usage;
+  for ( const auto& a : actors )
+  {
+    for ( size_t i = 0; i < usage.size(); ++i )
+      usage[ i ] += a.usage[ i ];
+  }
+
+  util::printf( "\nMemory by actor (MB, pets count towards their owner):\n" );
+  print_header( "actor" );
+  for ( const auto& a : actors )
+    print_usage( a.name, a.usage );
+  print_usage( "sim", sim_usage );
+  print_usage( "total", usage );
+
+  if ( ! threads.empty() )
+  {
+    util::printf( "\nMemory by thread before merge (MB):\n" );
+    print_header( "thread" );
+    for ( size_t i = 0; i < threads.size(); ++i )
+      print_usage( util::to_string( i ), threads[ i ] );
+  }
+
+  util::printf( "\nPeak resident memory: %.1f MB\n", megabytes( computer_process::peak_memory_usage() ) );
+}
+
+// memory_report_t::create_options ==========================================
+
+void memory_report_t::create_options()
+{
+  sim -> add_option( opt_bool( "report_memory", report ) );
+  sim -> add_option( opt_int( "report_memory_interval", interval ) );
+}
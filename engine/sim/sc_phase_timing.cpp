@@ -0,0 +1,135 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "simulationcraft.hpp"
+
+// ==========================================================================
+// Phase Timing
+// ==========================================================================
+
+// phase_timing_t::scope_t::scope_t =========================================
+
+phase_timing_t::scope_t::scope_t( phase_timing_t& t, const char* n ) :
+  timing( t ),
+  name( n ),
+  wall( util::wall_time() ),
+  cpu( util::cpu_time() )
+{ }
+
+// phase_timing_t::scope_t::~scope_t ========================================
+
+phase_timing_t::scope_t::~scope_t()
+{
+  timing.add_phase( name, util::wall_time() - wall, util::cpu_time() - cpu );
+}
+
+// phase_timing_t::phase_timing_t ===========================================
+
+phase_timing_t::phase_timing_t( sim_t* s ) :
+  sim( s ),
+  report( false ),
+  own()
+{
+  create_options();
+}
+
+// phase_timing_t::add_phase ================================================
+
+/// Phases with the same name (e.g. repeated report writers) are accumulated
+void phase_timing_t::add_phase( const std::string& name, double wall, double cpu )
+{
+  auto it = range::find_if( phases, [ &name ]( const phase_t& p ) { return p.name == name; } );
+  if ( it != phases.end() )
+  {
+    it -> wall += wall;
+    it -> cpu += cpu;
+  }
+  else
+  {
+    phases.push_back( phase_t{ name, wall, cpu } );
+  }
+}
+
+// phase_timing_t::add_thread ===============================================
+
+/// Called by child threads at the end of sim_t::run(), and for the main thread
+/// by sim_t::execute()
+void phase_timing_t::add_thread( const thread_t& thread )
+{
+  AUTO_LOCK( mutex );
+  threads.push_back( thread );
+}
+
+// phase_timing_t::finish_threads ===========================================
+
+/// Idle tail of every thread, the time it waited for the slowest thread to run
+/// out of work. Called once all threads have merged.
+void phase_timing_t::finish_threads()
+{
+  range::sort( threads, []( const thread_t& a, const thread_t& b ) { return a.index < b.index; } );
+
+  double last = 0;
+  for ( const auto& t : threads )
+    last = std::max( last, t.finish );
+
+  for ( auto& t : threads )
+    t.idle = last - t.finish;
+}
+
+// phase_timing_t::wall =====================================================
+
+/// Total wall clock seconds of the phases whose name starts with prefix
+double phase_timing_t::wall( const std::string& prefix ) const
+{
+  double total = 0;
+  for ( const auto& p : phases )
+  {
+    if ( p.name.compare( 0, prefix.size(), prefix ) == 0 )
+      total += p.wall;
+  }
+
+  return total;
+}
+
+// phase_timing_t::print ====================================================
+
+/// Text summary, printed after all reports are written with report_timing=1
+void phase_timing_t::print() const
+{
+  if ( ! report || sim -> parent )
+    return;
+
+  util::printf( "\nPhase timing:\n" );
+  util::printf( "  %-16s %10s %10s\n", "phase", "wall (s)", "cpu (s)" );
+  for ( const auto& p : phases )
+    util::printf( "  %-16s %10.3f %10.3f\n", p.name.c_str(), p.wall, p.cpu );
+
+  if ( threads.empty() )
+    return;
+
+  util::printf( "\nThread utilization:\n" );
+  util::printf( "  %-6s %10s %9s %9s %9s %9s %9s %7s %6s %5s\n",
+                "thread", "iterations", "init (s)", "run (s)", "merge (s)", "idle (s)", "cpu (s)", "busy", "proc", "node" );
+  bool pinned = false;
+  for ( const auto& t : threads )
+  {
+    double busy = t.run + t.idle > 0 ? 100.0 * t.run / ( t.run + t.idle ) : 100.0;
+    std::string processor = t.processor >= 0 ? util::to_string( t.processor ) + ( t.pinned ? "*" : "" ) : "-";
+    std::string node = t.node >= 0 ? util::to_string( t.node ) : "-";
+    util::printf( "  %-6d %10d %9.3f %9.3f %9.3f %9.3f %9.3f %6.1f%% %6s %5s\n",
+                  t.index, t.iterations, t.init, t.run, t.merge, t.idle, t.cpu, busy, processor.c_str(), node.c_str() );
+    pinned = pinned || t.pinned;
+  }
+
+  if ( pinned )
+    util::printf( "  * bound by thread_affinity, processor at the end of the run\n" );
+}
+
+// phase_timing_t::create_options ===========================================
+
+void phase_timing_t::create_options()
+{
+  sim -> add_option( opt_bool( "report_timing", report ) );
+}
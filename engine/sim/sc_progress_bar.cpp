@@ -13,7 +13,7 @@ progress_bar_t::progress_bar_t( sim_t& s ) :
 void progress_bar_t::init()
 {
   start_time = util::wall_time();
-  if ( sim.target_error > 0 )
+  if ( sim.target_error > 0 || sim.comparison -> enabled() )
   {
     interval = sim.analyze_error_interval;
   }
@@ -75,7 +75,7 @@ bool progress_bar_t::update( bool finished, int index )
 
   str::format( status, " %d/%d", finished ? progress.total_iterations : progress.current_iterations, progress.total_iterations );
 
-  if ( sim.target_error > 0 )
+  if ( sim.target_error > 0 && ! sim.comparison -> enabled() )
   {
     str::format( status, " Mean=%.0f Error=%.3f%%", sim.current_mean, sim.current_error );
   }
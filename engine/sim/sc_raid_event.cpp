@@ -187,6 +187,12 @@ struct adds_event_t : public raid_event_t
         p -> resources.base[ RESOURCE_HEALTH ] = health;
         p -> race = race;
         p -> race_str = util::race_type_string(race);
+        // Adds only need their damage taken accounted for, unless full data is asked for
+        if ( ! sim -> full_add_data_collection )
+        {
+          p -> minimal_data_collection = true;
+          p -> quiet = true;
+        }
         adds.push_back( p );
       }
     }
@@ -230,8 +236,7 @@ struct adds_event_t : public raid_event_t
         }
 
         adds[i] -> summon( saved_duration );
-        adds[i] -> x_position = x_offset + spawn_x_coord;
-        adds[i] -> y_position = y_offset + spawn_y_coord;
+        adds[i] -> set_position( x_offset + spawn_x_coord, y_offset + spawn_y_coord );
 
         if ( sim -> log )
         {
@@ -302,8 +307,7 @@ struct move_enemy_t : public raid_event_t
 
     if ( enemy )
     {
-      enemy -> x_position = enemy -> default_x_position;
-      enemy -> y_position = enemy -> default_y_position;
+      enemy -> set_position( enemy -> default_x_position, enemy -> default_y_position );
     }
   }
 
@@ -313,9 +317,9 @@ struct move_enemy_t : public raid_event_t
     {
       original_x = enemy -> x_position;
       original_y = enemy -> y_position;
-      enemy -> x_position = x_coord;
-      enemy -> y_position = y_coord;
-      regenerate_cache();
+      // Target caches only change if the enemy actually moves
+      if ( enemy -> set_position( x_coord, y_coord ) )
+        regenerate_cache();
     }
   }
 
@@ -323,9 +327,8 @@ struct move_enemy_t : public raid_event_t
   {
     if ( enemy )
     {
-      enemy -> x_position = enemy -> default_x_position;
-      enemy -> y_position = enemy -> default_y_position;
-      regenerate_cache();
+      if ( enemy -> set_position( enemy -> default_x_position, enemy -> default_y_position ) )
+        regenerate_cache();
     }
   }
 };
@@ -0,0 +1,234 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "simulationcraft.hpp"
+
+namespace
+{  // UNNAMED NAMESPACE ==========================================
+
+const uint32_t SHARD_MAGIC   = 0x48535353; // "SSSH"
+const uint32_t SHARD_VERSION = 2;
+const uint64_t SHARD_BASE_SEED = 31459;
+
+uint64_t shard_seed_offset( unsigned index )
+{ return static_cast<uint64_t>( index ) << 40; }
+
+bool parse_shard( shard_t* shard, const std::string& value )
+{
+  auto split = util::string_split( value, "/" );
+  if ( split.size() != 2 )
+    return false;
+
+  int index = util::to_int( split[ 0 ] );
+  int count = util::to_int( split[ 1 ] );
+  if ( count <= 0 || index < 0 || index >= count )
+    return false;
+
+  shard -> index = static_cast<unsigned>( index );
+  shard -> count = static_cast<unsigned>( count );
+
+  return true;
+}
+
+}  // UNNAMED NAMESPACE ====================================================
+
+// ==========================================================================
+// Shard
+// ==========================================================================
+
+// shard_t::shard_t =========================================================
+
+shard_t::shard_t( sim_t* s ) :
+  sim( s ),
+  index( 0 ),
+  count( 0 )
+{
+  create_options();
+}
+
+// shard_t::setup ===========================================================
+
+/// Slice the iterations of the baseline sim, called before the work queue is initialized
+void shard_t::setup()
+{
+  if ( ! enabled() && ! merging() )
+    return;
+
+  if ( enabled() && merging() )
+  {
+    throw std::invalid_argument( "shard and shard_merge cannot be used together." );
+  }
+
+  if ( sim -> scaling -> calculate_scale_factors || ! sim -> plot -> dps_plot_stat_str.empty() ||
+       ! sim -> reforge_plot -> reforge_plot_stat_str.empty() || sim -> single_actor_batch )
+  {
+    throw std::invalid_argument( "Sharded simulations only support the baseline simulation "
+                                 "(no scale factors, plots or single_actor_batch)." );
+  }
+
+  if ( ! enabled() )
+    return;
+
+  if ( sim -> target_error > 0 || sim -> comparison -> enabled() )
+  {
+    throw std::invalid_argument( "shard requires a fixed iteration count (iterations=N without target_error or comparison_confidence)." );
+  }
+
+  int total = sim -> iterations;
+  int remainder = total % static_cast<int>( count );
+  sim -> iterations = total / static_cast<int>( count ) + ( static_cast<int>( index ) < remainder ? 1 : 0 );
+  if ( sim -> iterations <= 0 )
+  {
+    std::stringstream s;
+    s << "Shard " << index << "/" << count << " has no iterations to run, increase iterations.";
+    throw std::invalid_argument( s.str() );
+  }
+
+  // Every shard derives its seed from a common base seed, so a shard=i/N run is
+  // reproducible; shards (and the threads within them) must not share random
+  // streams. Without a user given seed the base is the deterministic=1 seed.
+  if ( sim -> seed == 0 )
+  {
+    sim -> seed = SHARD_BASE_SEED;
+  }
+  sim -> seed += shard_seed_offset( index );
+
+  if ( output_file_str.empty() )
+  {
+    output_file_str = "shard_" + util::to_string( index ) + "_of_" + util::to_string( count ) + ".bin";
+  }
+}
+
+// shard_t::write ===========================================================
+
+/// Write the merged (but not yet analyzed) state of the shard
+bool shard_t::write()
+{
+  serialize::writer_t w;
+  w.write( SHARD_MAGIC );
+  w.write( SHARD_VERSION );
+  w.write( index );
+  w.write( count );
+  w.write( static_cast<uint64_t>( sim -> seed ) );
+  w.write( sim -> iterations );
+  w.write_string( checkpoint_t::save_state( *sim ) );
+
+  io::ofstream out;
+  out.open( output_file_str, std::ios::out | std::ios::trunc | std::ios::binary );
+  if ( ! out.is_open() )
+  {
+    sim -> errorf( "Unable to open shard output file '%s'.\n", output_file_str.c_str() );
+    return false;
+  }
+
+  out.write( w.data().data(), w.data().size() );
+  out.close();
+  if ( out.fail() )
+  {
+    sim -> errorf( "Unable to write shard output file '%s'.\n", output_file_str.c_str() );
+    return false;
+  }
+
+  util::printf( "Wrote shard %u/%u ( iterations=%d, seed=%llu ) to '%s'\n",
+                index, count, sim -> iterations, sim -> seed, output_file_str.c_str() );
+
+  return true;
+}
+
+// shard_t::merge ===========================================================
+
+/// Initialize the main sim and fold all shard files into it
+bool shard_t::merge()
+{
+  if ( ! sim -> init() )
+    return false;
+
+  // Target data, and the debuffs in it, is created on first use in combat.
+  // The merging sim runs no combat, so create it up front for the shard data
+  // to have a counterpart.
+  for ( auto p : sim -> actor_list )
+  {
+    for ( auto t : sim -> target_list )
+      p -> get_target_data( t );
+  }
+
+  std::vector<unsigned> merged;
+  unsigned expected = 0;
+  int iterations = 0;
+
+  for ( const auto& file : util::string_split( merge_file_str, "," ) )
+  {
+    io::ifstream in;
+    in.open( file, std::ios::in | std::ios::binary );
+    if ( ! in.is_open() )
+    {
+      sim -> errorf( "Unable to open shard file '%s'.\n", file.c_str() );
+      return false;
+    }
+
+    std::string data( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+
+    try
+    {
+      serialize::reader_t r( data );
+      if ( r.read<uint32_t>() != SHARD_MAGIC )
+        throw std::runtime_error( "not a shard file" );
+      if ( r.read<uint32_t>() != SHARD_VERSION )
+        throw std::runtime_error( "unsupported shard format version" );
+
+      unsigned shard_index = r.read<unsigned>();
+      unsigned shard_count = r.read<unsigned>();
+      uint64_t shard_seed = r.read<uint64_t>();
+      int shard_iterations = r.read<int>();
+
+      if ( expected == 0 )
+        expected = shard_count;
+      else if ( shard_count != expected )
+        throw std::runtime_error( "shard count differs from previously merged shards" );
+
+      if ( range::find( merged, shard_index ) != merged.end() )
+        throw std::runtime_error( "shard " + util::to_string( shard_index ) + " was already merged" );
+
+      uint64_t base_seed = shard_seed - shard_seed_offset( shard_index );
+      if ( ! merged.empty() && base_seed != sim -> seed )
+        throw std::runtime_error( "shard was run with a different base seed than previously merged shards" );
+
+      checkpoint_t::merge_state( *sim, r.read_string() );
+
+      if ( merged.empty() )
+        sim -> seed = base_seed;
+
+      merged.push_back( shard_index );
+      iterations += shard_iterations;
+    }
+    catch ( const std::exception& e )
+    {
+      sim -> errorf( "Unable to merge shard file '%s': %s\n", file.c_str(), e.what() );
+      return false;
+    }
+  }
+
+  if ( merged.size() < expected )
+  {
+    sim -> errorf( "Only %u of %u shards were merged.\n",
+                   static_cast<unsigned>( merged.size() ), expected );
+  }
+
+  sim -> iterations = iterations;
+
+  util::printf( "Merged %u shards ( iterations=%d )\n", static_cast<unsigned>( merged.size() ), iterations );
+
+  return iterations > 0;
+}
+
+// shard_t::create_options ==================================================
+
+void shard_t::create_options()
+{
+  sim -> add_option( opt_func( "shard", [ this ]( sim_t*, const std::string&, const std::string& value ) {
+    return parse_shard( this, value ); } ) );
+  sim -> add_option( opt_string( "shard_output", output_file_str ) );
+  sim -> add_option( opt_string( "shard_merge", merge_file_str ) );
+}
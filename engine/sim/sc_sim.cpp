@@ -93,6 +93,32 @@ bool parse_debug_seed( sim_t* sim, const std::string&, const std::string& value
   return sim -> debug_seed.size() > 0;
 }
 
+// parse_sequence_iterations ================================================
+
+bool parse_sequence_iterations( sim_t* sim, const std::string&, const std::string& value )
+{
+  sim -> sequence_iterations.clear();
+
+  auto split = util::string_split( value, ":/," );
+  for ( const auto& iteration_str : split )
+  {
+    int iteration = util::to_int( iteration_str );
+    if ( iteration < 0 )
+    {
+      sim -> errorf( "Invalid sequence iteration '%s'", iteration_str.c_str() );
+      return false;
+    }
+
+    sim -> sequence_iterations.push_back( iteration );
+  }
+
+  range::sort( sim -> sequence_iterations );
+  sim -> sequence_iterations.erase( std::unique( sim -> sequence_iterations.begin(),
+    sim -> sequence_iterations.end() ), sim -> sequence_iterations.end() );
+
+  return true;
+}
+
 // parse_ptr ================================================================
 
 bool parse_ptr( sim_t*             sim,
@@ -743,6 +769,8 @@ bool parse_spell_query( sim_t*             sim,
   std::string sq_str = value;
   size_t lvl_offset = std::string::npos;
 
+  sim -> spell_query_str = value;
+
   if ( ( lvl_offset = value.rfind( "@" ) ) != std::string::npos )
   {
     std::string lvl_offset_str = value.substr( lvl_offset + 1 );
@@ -1346,9 +1374,10 @@ sim_t::sim_t( sim_t* p, int index ) :
   travel_variance( 0 ), default_skill( 1.0 ), reaction_time( timespan_t::from_seconds( 0.5 ) ),
   regen_periodicity( timespan_t::from_seconds( 0.25 ) ),
   ignite_sampling_delta( timespan_t::from_seconds( 0.2 ) ),
-  fixed_time( false ), optimize_expressions( false ),
+  fixed_time( false ), optimize_expressions( false ), sparse_timelines( false ), sparse_buff_data( false ), init_timing( false ),
   current_slot( -1 ),
-  optimal_raid( 0 ), log( 0 ), debug_each( 0 ), save_profiles( 0 ), default_actions( 0 ),
+  optimal_raid( 0 ), log( 0 ), debug_each( 0 ), sequence_iterations(), record_sequence( false ),
+  save_profiles( 0 ), default_actions( 0 ),
   normalized_stat( STAT_NONE ),
   default_region_str( "us" ),
   save_prefix_str( "save_" ),
@@ -1363,7 +1392,7 @@ sim_t::sim_t( sim_t* p, int index ) :
   disable_set_bonuses( false ), disable_2_set( 1 ), disable_4_set( 1 ), enable_2_set( 1 ), enable_4_set( 1 ),
   pvp_crit( false ),
   active_enemies( 0 ), active_allies( 0 ),
-  _rng(), seed( 0 ), deterministic( false ),
+  _rng(), seed( 0 ), deterministic( false ), deterministic_iterations( false ), global_iteration( -1 ),
   average_range( true ), average_gauss( false ),
   convergence_scale( 2 ),
   fight_style( "Patchwerk" ), add_waves( 0 ), overrides( overrides_t() ),
@@ -1373,6 +1402,13 @@ sim_t::sim_t( sim_t* p, int index ) :
   scaling( new scaling_t( this ) ),
   plot( new plot_t( this ) ),
   reforge_plot( new reforge_plot_t( this ) ),
+  checkpoint( new checkpoint_t( this ) ),
+  shard( new shard_t( this ) ),
+  iteration_export( new iteration_export_t( this ) ),
+  timing( new phase_timing_t( this ) ),
+  comparison( new comparison_t( this ) ),
+  affinity( new thread_affinity_t( this ) ),
+  memory( new memory_report_t( this ) ),
   elapsed_cpu( 0.0 ),
   elapsed_time( 0.0 ),
   iteration_dmg( 0 ), priority_iteration_dmg( 0 ), iteration_heal( 0 ), iteration_absorb( 0 ),
@@ -1382,7 +1418,7 @@ sim_t::sim_t( sim_t* p, int index ) :
   report_progress( 1 ),
   bloodlust_percent( 25 ), bloodlust_time( timespan_t::from_seconds( 0.5 ) ),
   // Report
-  report_precision(2), report_pets_separately( 0 ), report_targets( 1 ), report_details( 1 ), report_raw_abilities( 1 ),
+  report_precision(2), report_pets_separately( 0 ), full_add_data_collection( false ), report_targets( 1 ), report_details( 1 ), report_raw_abilities( 1 ),
   report_rng( 0 ), hosted_html( 0 ),
   save_raid_summary( 0 ), save_gear_comments( 0 ), statistics_level( 1 ), separate_stats_by_actions( 0 ), report_raid_summary( 0 ), buff_uptime_timeline( 0 ),
   decorated_tooltips( -1 ),
@@ -1436,6 +1472,10 @@ sim_t::sim_t( sim_t* p, int index ) :
     // While we inherit the parent seed, it may get overwritten in sim_t::init
     seed = parent -> seed;
 
+    // The main sim may have turned off a seeding mode in setup
+    deterministic = parent -> deterministic;
+    deterministic_iterations = parent -> deterministic_iterations;
+
     parent -> add_relative( this );
   }
 }
@@ -1456,6 +1496,16 @@ double sim_t::iteration_time_adjust() const
   if ( iterations <= 1 )
     return 1.0;
 
+  // Depends only on the global iteration number, not on the iterations a thread ran before
+  if ( deterministic_iterations )
+  {
+    if ( global_iteration <= 0 )
+      return 1.0;
+
+    return 1.0 + vary_combat_length * ( ( global_iteration % 2 ) ? 1 : -1 ) *
+           global_iteration / static_cast<double>( work_queue -> size() );
+  }
+
   if ( current_iteration == 0 )
     return 1.0;
 
@@ -1588,6 +1638,10 @@ void sim_t::reset()
 
   event_mgr.reset();
 
+  // Pending DoT ticks were flushed with the events of the previous iteration
+  for ( auto& actor : actor_list )
+    actor -> dot_ticks.reset();
+
   expected_iteration_time = max_time * iteration_time_adjust();
 
   for ( auto& buff : buff_list )
@@ -1651,6 +1705,22 @@ void sim_t::combat_begin()
 
   reset();
 
+  // Record the action sequence of the chosen iterations, or by default the first iteration that
+  // collects data
+  if ( sequence_iterations.empty() )
+  {
+    record_sequence = ( iterations <= 1 && current_iteration == 0 ) ||
+                      ( iterations > 1 && current_iteration == 1 );
+  }
+  else
+  {
+    // Iterations are numbered per thread, and only the sequences of the main
+    // thread are reported
+    record_sequence = thread_index == 0 &&
+                      std::binary_search( sequence_iterations.begin(), sequence_iterations.end(),
+                                          current_iteration );
+  }
+
   // Debug seed needs to be done _after_ sim reset, because deterministic=1 will reseed in
   // sim_t::reset()
   if ( debug_seed.size() > 0 )
@@ -1809,7 +1879,12 @@ void sim_t::datacollection_begin()
       p -> datacollection_begin();
     }
   }
-  make_event<resource_timeline_collect_event_t>( *this, *this );
+
+  // Sparse timelines are recorded by the actors themselves, when a value changes
+  if ( ! sparse_timelines )
+  {
+    make_event<resource_timeline_collect_event_t>( *this, *this );
+  }
 }
 
 // sim_t::datacollection_end ================================================
@@ -1840,6 +1915,8 @@ void sim_t::datacollection_end()
     }
   }
 
+  comparison -> collect();
+
   for ( size_t i = 0; i < buff_list.size(); ++i )
   {
     buff_t* b = buff_list[ i ];
@@ -1853,6 +1930,8 @@ void sim_t::datacollection_end()
   total_absorb.add( iteration_absorb );
   raid_aps.add( current_time() != timespan_t::zero() ? iteration_absorb / current_time().total_seconds() : 0 );
 
+  iteration_export -> add_row();
+
   if ( deterministic && report_iteration_data > 0 && current_iteration > 0 && current_time() > timespan_t::zero() )
   {
     // TODO: Metric should be selectable
@@ -1888,10 +1967,19 @@ void sim_t::datacollection_end()
 void sim_t::analyze_error()
 {
   if ( thread_index != 0 ) return;
-  if ( target_error <= 0 ) return;
   if ( current_iteration < 1 ) return;
   if ( current_iteration % analyze_error_interval != 0 ) return;
 
+  // The comparison replaces the error target as the stopping rule
+  if ( comparison -> enabled() )
+  {
+    if ( comparison -> analyze() )
+      interrupt();
+    return;
+  }
+
+  if ( target_error <= 0 ) return;
+
   double mean_total=0;
   int mean_count=0;
 
@@ -2141,6 +2229,7 @@ bool sim_t::init_actors()
 bool sim_t::init_actor( player_t* p )
 {
   bool ret = true;
+  double start_time = util::wall_time();
 
   // initialize class/enemy modules
   for ( player_e i = PLAYER_NONE; i < PLAYER_MAX; ++i )
@@ -2226,6 +2315,8 @@ bool sim_t::init_actor( player_t* p )
   p -> init_absorb_priority();
   p -> init_assessors();
 
+  p -> init_time += util::wall_time() - start_time;
+
   return ret;
 }
 
@@ -2267,6 +2358,28 @@ bool sim_t::init_actor_pets()
   return actor_init;
 }
 
+// sim_t::print_init_timing ================================================
+
+/// Initialization time and registry sizes of each actor, one line per actor so the output is easy
+/// to parse (see util_scripts/init_benchmark.py).
+void sim_t::print_init_timing() const
+{
+  double total = 0;
+  for ( const auto actor : actor_list )
+  {
+    util::printf( "init_time actor=%s time=%.3fms symbols=%u buffs=%u cooldowns=%u stats=%u gains=%u "
+                  "procs=%u dots=%u actions=%u\n",
+                  actor -> name(), actor -> init_time * 1000.0,
+                  as<unsigned>( actor -> symbols.size() ), as<unsigned>( actor -> buff_list.size() ),
+                  as<unsigned>( actor -> cooldown_list.size() ), as<unsigned>( actor -> stats_list.size() ),
+                  as<unsigned>( actor -> gain_list.size() ), as<unsigned>( actor -> proc_list.size() ),
+                  as<unsigned>( actor -> dot_list.size() ), as<unsigned>( actor -> action_list.size() ) );
+    total += actor -> init_time;
+  }
+
+  util::printf( "init_time total actors=%u time=%.3fms\n", as<unsigned>( actor_list.size() ), total * 1000.0 );
+}
+
 // sim_t::init ==============================================================
 
 bool sim_t::init()
@@ -2281,7 +2394,7 @@ bool sim_t::init()
   // Seed RNG
   if ( seed == 0 )
   {
-    if( deterministic )
+    if( deterministic || deterministic_iterations )
     {
       seed = 31459;
     }
@@ -2292,7 +2405,7 @@ bool sim_t::init()
     }
   }
   _rng = rng::create( rng::parse_type( rng_str ) );
-  _rng -> seed( seed + thread_index );
+  _rng -> seed( seed + thread_index + checkpoint -> seed_offset() );
 
   if (   queue_lag_stddev == timespan_t::zero() )   queue_lag_stddev =   queue_lag * 0.25;
   if (     gcd_lag_stddev == timespan_t::zero() )     gcd_lag_stddev =     gcd_lag * 0.25;
@@ -2388,6 +2501,8 @@ bool sim_t::init()
   // Initialize actors
   if ( ! init_actors() ) return false;
 
+  comparison -> init();
+
   if ( report_precision < 0 ) report_precision = 2;
 
   simulation_length.reserve( std::min( iterations, 10000 ) );
@@ -2410,12 +2525,15 @@ bool sim_t::init()
 
     for ( auto& actor : actor_list )
     {
+      double start_time = util::wall_time();
 
       if ( ! actor -> init_finished() )
       {
         ret = false;
       }
 
+      actor -> init_time += util::wall_time() - start_time;
+
       // Some verification stuff to avoid user mistakes
 
       // .. nag if the user has not added an use_item line for each on-use item
@@ -2431,6 +2549,28 @@ bool sim_t::init()
       return false;
     }
 
+    if ( optimize_expressions )
+    {
+      apl_optimization_t apl_stats;
+      for ( auto& actor : actor_list )
+      {
+        actor -> optimize_action_lists( apl_stats );
+      }
+
+      if ( ! parent && apl_stats.entries > 0 )
+      {
+        util::printf( "Optimized action lists: removed %u of %u entries ( %u false conditions, %u empty calls, "
+                      "%u constant variable assignments ), %u constant variables, %u always true conditions\n",
+                      apl_stats.removed(), apl_stats.entries, apl_stats.false_conditions, apl_stats.empty_calls,
+                      apl_stats.variable_entries, apl_stats.constant_variables, apl_stats.true_conditions );
+      }
+    }
+
+    if ( init_timing && ! parent )
+    {
+      print_init_timing();
+    }
+
     if ( ! verify_use_items_state )
     {
       errorf( "Disable this warning by adding 'use_item' actions into the action priority list "
@@ -2449,14 +2589,29 @@ bool sim_t::init()
 
 void sim_t::analyze()
 {
+  phase_timing_t::scope_t t( *timing, "analyze" );
+
   simulation_length.analyze();
   if ( simulation_length.mean() == 0 ) return;
 
+  comparison -> finish();
+
   for ( size_t i = 0; i < buff_list.size(); ++i )
     buff_list[ i ] -> analyze();
 
   for ( size_t i = 0; i < actor_list.size(); i++ )
-    actor_list[ i ] -> analyze( *this );
+  {
+    player_t* actor = actor_list[ i ];
+
+    // Pool members that were never spawned are left out of analysis and reporting
+    if ( actor -> is_pet() && actor -> cast_pet() -> idle_pool_member() )
+    {
+      actor -> quiet = true;
+      continue;
+    }
+
+    actor -> analyze( *this );
+  }
 
   range::sort( players_by_dps,  compare_dps() );
   range::sort( players_by_priority_dps, compare_priority_dps() );
@@ -2507,8 +2662,16 @@ void sim_t::analyze_iteration_data()
 
 bool sim_t::iterate()
 {
-  if ( ! init() )
-    return false;
+  stopwatch_t thread_cpu( STOPWATCH_THREAD );
+  double init_start = util::wall_time();
+  {
+    phase_timing_t::scope_t t( *timing, "init" );
+    if ( ! init() )
+      return false;
+  }
+  double run_start = util::wall_time();
+
+  iteration_export -> start();
 
   progress_bar.init();
 
@@ -2517,13 +2680,21 @@ bool sim_t::iterate()
     sim_phase_str = "Generating " + player_no_pet_list[ current_index ] -> name_str;
   }
 
+  phase_timing_t::scope_t iterations_timer( *timing, "iterations" );
+
   bool more_work = true;
   do
   {
+    if ( deterministic_iterations && ! seed_iteration() )
+      break;
+
     ++current_iteration;
 
     combat();
 
+    checkpoint -> iteration_end();
+    memory -> iteration_end();
+
     if ( progress_bar.update() )
     {
       util::fprintf( stdout, "%s %s\r", sim_phase_str.c_str(), progress_bar.status.c_str() );
@@ -2532,7 +2703,9 @@ bool sim_t::iterate()
 
     do_pause();
     auto old_active = current_index;
-    current_index = work_queue -> pop();
+    // The warm-up iteration of deterministic_iterations did not claim work
+    if ( ! deterministic_iterations || global_iteration >= 0 )
+      current_index = work_queue -> pop();
 
     if ( ! single_actor_batch )
     {
@@ -2565,13 +2738,70 @@ bool sim_t::iterate()
     fflush( stdout );
   }
 
+  // With threads > 1 the main thread runs only its share of the iterations
+  if ( ! parent && ! canceled && ! sequence_iterations.empty() && sequence_iterations.back() > current_iteration )
+  {
+    errorf( "sequence_iterations counts the iterations of the main thread, which ran %d of %d. "
+            "Later iterations were not recorded.\n", current_iteration + 1, work_queue -> size() );
+  }
+
+  checkpoint -> iteration_end( true );
+  iteration_export -> finish_thread();
+
   reset();
 
-  iterations = current_iteration + 1;
+  timing -> own.index = thread_index;
+  timing -> own.iterations = current_iteration + 1;
+  timing -> own.init = run_start - init_start;
+  timing -> own.finish = util::wall_time();
+  timing -> own.run = timing -> own.finish - run_start;
+  timing -> own.cpu = thread_cpu.elapsed();
+  affinity -> placement( timing -> own );
+  memory -> finish_thread();
+
+  // The warm-up iteration of deterministic_iterations is not part of the results
+  bool warmup = deterministic_iterations && iterations > 1 && current_iteration >= 0;
+
+  iterations = current_iteration + 1 + checkpoint -> restored_iterations() - warmup;
 
   return iterations > 0;
 }
 
+// sim_t::seed_iteration ====================================================
+
+/**
+ * Seed the rng of the next iteration for deterministic_iterations=1.
+ *
+ * Every collected iteration claims its global iteration number from the shared
+ * work queue and draws from its own random stream of ( seed, number ), so the
+ * simulated iterations do not depend on the thread count or on which thread
+ * runs them. The uncollected warm-up iteration of each thread uses the same
+ * stream on every thread, so state calibrated in it (e.g. target health) is
+ * identical as well.
+ *
+ * Returns false once all work has been claimed.
+ */
+bool sim_t::seed_iteration()
+{
+  if ( iterations > 1 && current_iteration < 0 )
+  {
+    global_iteration = -1;
+    rng().seed( rng::stream_seed( seed, ~uint64_t( 0 ) ) );
+  }
+  else
+  {
+    global_iteration = work_queue -> claim();
+    if ( global_iteration < 0 )
+      return false;
+
+    rng().seed( rng::stream_seed( seed, static_cast<uint64_t>( global_iteration ) ) );
+  }
+
+  rng().reset();
+
+  return true;
+}
+
 /**
  * @brief pause simulator
  *
@@ -2602,6 +2832,10 @@ void sim_t::merge( sim_t& other_sim )
 {
   auto_lock_t auto_lock( merge_mutex );
 
+  // Merge time starts once the lock is held, waiting for the parent to finish its own iterations
+  // is idle time of the other sim
+  double merge_start = util::wall_time();
+
   iterations += other_sim.iterations;
 
   simulation_length.merge( other_sim.simulation_length );
@@ -2625,10 +2859,17 @@ void sim_t::merge( sim_t& other_sim )
   {
     player_t* other_p = other_sim.find_player( player -> index );
     assert( other_p );
+
+    // Pool members never spawned in the other sim have nothing to merge
+    if ( other_p -> is_pet() && other_p -> cast_pet() -> idle_pool_member() )
+      continue;
+
     player -> merge( *other_p );
   }
 
   range::append( iteration_data, other_sim.iteration_data );
+
+  other_sim.timing -> own.merge = util::wall_time() - merge_start;
 }
 
 /// merge all sims together
@@ -2645,6 +2886,11 @@ void sim_t::merge()
     if ( child )
     {
       child -> join();
+      if ( deterministic_iterations && child -> iterations > 0 )
+      {
+        merge( *child );
+        timing -> add_thread( child -> timing -> own );
+      }
       children[ i ] = nullptr;
       delete child;
     }
@@ -2657,9 +2903,13 @@ void sim_t::merge()
 
 void sim_t::run()
 {
-  if( iterate() )
+  affinity -> pin();
+
+  // With deterministic_iterations the main thread merges the children in thread order
+  if( iterate() && ! deterministic_iterations )
   {
     parent -> merge( *this );
+    parent -> timing -> add_thread( timing -> own );
   }
 }
 
@@ -2669,6 +2919,10 @@ void sim_t::partition()
 {
   iterations = work_queue -> size();
 
+  // The main thread is bound before it initializes as well
+  affinity -> plan();
+  affinity -> pin();
+
   if ( threads <= 1 )
     return;
   if ( iterations < threads )
@@ -2714,6 +2968,15 @@ void sim_t::partition()
     child -> report_progress = 0;
   }
 
+  // With deterministic_iterations the threads share the work queue as well, but keep the
+  // full iteration count so that every thread runs (and discards) a warm-up iteration
+  if ( deterministic_iterations )
+  {
+    iterations = work_queue -> size();
+    for ( auto child : children )
+      child -> iterations = iterations;
+  }
+
   computer_process::set_priority( process_priority ); // Set main thread priority
 
   for ( auto & child : children )
@@ -2727,11 +2990,48 @@ bool sim_t::execute()
   double start_cpu_time  = util::cpu_time();
   double start_wall_time = util::wall_time();
 
-  partition();
-  bool success = iterate();
-  merge(); // Always merge, even in cases of unsuccessful simulation!
-  if( success )
+  if ( shard -> merging() )
+  {
+    {
+      phase_timing_t::scope_t t( *timing, "shard_merge" );
+      if ( ! shard -> merge() )
+        return false;
+    }
+
     analyze();
+  }
+  else
+  {
+    if ( ! checkpoint -> start() )
+      return false;
+
+    {
+      phase_timing_t::scope_t t( *timing, "thread_launch" );
+      partition();
+    }
+    bool success = iterate();
+    if ( success )
+      timing -> add_thread( timing -> own );
+    {
+      phase_timing_t::scope_t t( *timing, "merge" );
+      merge(); // Always merge, even in cases of unsuccessful simulation!
+    }
+    // Other threads may have claimed all work of the main thread
+    if ( deterministic_iterations )
+      success = iterations > 0;
+    timing -> finish_threads();
+    checkpoint -> finish();
+    iteration_export -> finish();
+
+    // Shard results are analyzed by the run merging all shards
+    if ( shard -> enabled() )
+    {
+      if ( ! shard -> write() )
+        return false;
+    }
+    else if( success )
+      analyze();
+  }
 
   elapsed_cpu  = util::cpu_time()  - start_cpu_time;
   elapsed_time = util::wall_time() - start_wall_time;
@@ -2987,12 +3287,16 @@ void sim_t::create_options()
   add_option( opt_float( "confidence", confidence, 0.0, 1.0 ) );
   add_option( opt_func( "spell_query", parse_spell_query ) );
   add_option( opt_string( "spell_query_xml_output_file", spell_query_xml_output_file_str ) );
+  add_option( opt_string( "spell_query_file", spell_query_file_str ) );
   add_option( opt_func( "item_db_source", parse_item_sources ) );
   add_option( opt_func( "proxy", parse_proxy ) );
   add_option( opt_int( "auto_ready_trigger", auto_ready_trigger ) );
   add_option( opt_int( "stat_cache", stat_cache ) );
   add_option( opt_int( "max_aoe_enemies", max_aoe_enemies ) );
   add_option( opt_bool( "optimize_expressions", optimize_expressions ) );
+  add_option( opt_bool( "sparse_timelines", sparse_timelines ) );
+  add_option( opt_bool( "sparse_buff_data", sparse_buff_data ) );
+  add_option( opt_bool( "init_timing", init_timing ) );
   add_option( opt_bool( "single_actor_batch", single_actor_batch ) );
   // Raid buff overrides
   add_option( opt_func( "optimal_raid", parse_optimal_raid ) );
@@ -3024,9 +3328,11 @@ void sim_t::create_options()
   add_option( opt_bool( "debug", debug ) );
   add_option( opt_bool( "debug_each", debug_each ) );
   add_option( opt_func( "debug_seed", parse_debug_seed ) );
+  add_option( opt_func( "sequence_iterations", parse_sequence_iterations ) );
   add_option( opt_string( "html", html_file_str ) );
   add_option( opt_string( "json", json_file_str ) );
   add_option( opt_string( "json2", json2_file_str ) );
+  add_option( opt_string( "bench_file", bench_file_str ) );
   add_option( opt_bool( "hosted_html", hosted_html ) );
   add_option( opt_int( "healing", healing ) );
   add_option( opt_string( "xml", xml_file_str ) );
@@ -3049,6 +3355,7 @@ void sim_t::create_options()
   // RNG
   add_option( opt_string( "rng", rng_str ) );
   add_option( opt_bool( "deterministic", deterministic ) );
+  add_option( opt_bool( "deterministic_iterations", deterministic_iterations ) );
   add_option( opt_float( "report_iteration_data", report_iteration_data ) );
   add_option( opt_int( "min_report_iteration_data", min_report_iteration_data ) );
   add_option( opt_bool( "average_range", average_range ) );
@@ -3144,6 +3451,7 @@ void sim_t::create_options()
   // Report
   add_option( opt_int( "report_precision", report_precision ) );
   add_option( opt_bool( "report_pets_separately", report_pets_separately ) );
+  add_option( opt_bool( "full_add_data_collection", full_add_data_collection ) );
   add_option( opt_bool( "report_targets", report_targets ) );
   add_option( opt_bool( "report_details", report_details ) );
   add_option( opt_bool( "report_raw_abilities", report_raw_abilities ) );
@@ -3239,7 +3547,7 @@ void sim_t::setup( sim_control_t* c )
 
   }
 
-  if ( player_list.empty() && spell_query == nullptr )
+  if ( player_list.empty() && spell_query == nullptr && spell_query_file_str.empty() )
   {
     throw std::runtime_error( "Nothing to sim!" );
   }
@@ -3316,6 +3624,11 @@ void sim_t::setup( sim_control_t* c )
     }
   }
 
+  if ( ! parent )
+  {
+    shard -> setup();
+  }
+
   if ( single_actor_batch )
   {
     work_queue -> batches( player_no_pet_list.size() );
@@ -3326,6 +3639,28 @@ void sim_t::setup( sim_control_t* c )
   {
     errorf( "deterministic=1 cannot be used with non-zero target_error values!\n" );
   }
+
+  if ( deterministic_iterations && ! parent )
+  {
+    if ( single_actor_batch )
+    {
+      errorf( "deterministic_iterations=1 cannot be used with single_actor_batch=1, disabling it.\n" );
+      deterministic_iterations = false;
+    }
+    else
+    {
+      if ( deterministic )
+      {
+        errorf( "deterministic_iterations=1 replaces deterministic=1.\n" );
+        deterministic = false;
+      }
+
+      if ( target_error != 0 )
+      {
+        errorf( "deterministic_iterations=1 cannot be used with non-zero target_error values!\n" );
+      }
+    }
+  }
 }
 
 // sim_t::progress ==========================================================
@@ -3436,13 +3771,29 @@ void sim_t::abort()
 /// add chart to sim for end of report processing
 void sim_t::add_chart_data( const highchart::chart_t& chart )
 {
+  auto options = chart.to_json_options( [ this ]( const std::string& series ) {
+    auto it = chart_series_index.insert( std::make_pair( series, chart_series.size() ) );
+    if ( it.second )
+    {
+      chart_series.push_back( &it.first -> first );
+    }
+    return it.first -> second;
+  } );
+
+  auto it = chart_options_index.insert( std::make_pair( options, chart_options.size() ) );
+  if ( it.second )
+  {
+    chart_options.push_back( &it.first -> first );
+  }
+
+  auto data = std::make_pair( chart.id_str_, it.first -> second );
   if ( chart.toggle_id_str_.empty() )
   {
-    on_ready_chart_data.push_back( chart.to_aggregate_string( false ) );
+    on_ready_chart_data.push_back( data );
   }
   else
   {
-    chart_data[ chart.toggle_id_str_ ].push_back( chart.to_data() );
+    chart_data[ chart.toggle_id_str_ ].push_back( data );
   }
 }
 
@@ -3466,6 +3817,78 @@ void sim_t::print_spell_query()
   }
 }
 
+/* Batch mode of spell_query: every line of spell_query_file is a query in the
+ * spell_query= syntax, empty lines and lines starting with # are skipped. A
+ * query given with spell_query= is run as the first query of the batch. All
+ * queries share the spell data indexes of the process. Text output separates
+ * the queries with a header line, xml output writes one spell_query node per
+ * query into spell_query_xml_output_file.
+ */
+void sim_t::print_spell_query_file()
+{
+  io::ifstream in;
+  in.open( spell_query_file_str );
+  if ( ! in.is_open() )
+  {
+    throw std::invalid_argument( "Unable to open spell query file '" + spell_query_file_str + "'" );
+  }
+
+  std::shared_ptr<xml_node_t> root;
+  if ( ! spell_query_xml_output_file_str.empty() )
+    root = std::shared_ptr<xml_node_t>( new xml_node_t( "spell_queries" ) );
+
+  auto print = [ this, &root ]( const std::string& query ) {
+    spell_query -> evaluate();
+
+    if ( root )
+    {
+      xml_node_t* node = root -> add_child( "spell_query" );
+      node -> add_parm( "query", query );
+      report::print_spell_query( node, *this, *spell_query, spell_query_level );
+    }
+    else
+    {
+      std::cout << "# spell_query=" << query << " results=" << spell_query -> result_spell_list.size() << "\n";
+      report::print_spell_query( std::cout, *this, *spell_query, spell_query_level );
+    }
+  };
+
+  if ( spell_query )
+  {
+    print( spell_query_str );
+  }
+
+  std::string line;
+  while ( std::getline( in, line ) )
+  {
+    if ( ! line.empty() && line.back() == '\r' )
+      line.pop_back();
+    if ( line.empty() || line[ 0 ] == '#' )
+      continue;
+
+    spell_query_level = MAX_LEVEL;
+    if ( ! parse_spell_query( this, "spell_query", line ) )
+    {
+      errorf( "Unable to parse spell query '%s'\n", line.c_str() );
+      continue;
+    }
+
+    print( line );
+  }
+
+  if ( ! root )
+    return;
+
+  io::cfile file( spell_query_xml_output_file_str.c_str(), "w" );
+  if ( ! file )
+  {
+    std::cerr << "Unable to open spell query xml output file '" << spell_query_xml_output_file_str << "', using stdout instead\n";
+    file = io::cfile( stdout, io::cfile::no_close() );
+  }
+  util::fprintf( file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" );
+  root -> print_xml( file );
+}
+
 /* Build a divisor timeline vector appropriate to a given timeline
  * bucket size, from given simulation length data.
  */
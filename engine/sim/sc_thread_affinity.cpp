@@ -0,0 +1,180 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "simulationcraft.hpp"
+
+// ==========================================================================
+// Thread Affinity
+// ==========================================================================
+
+// thread_affinity_t::thread_affinity_t =====================================
+
+thread_affinity_t::thread_affinity_t( sim_t* s ) :
+  sim( s ),
+  mode( NONE ),
+  pinned( false )
+{
+  create_options();
+}
+
+// thread_affinity_t::plan ==================================================
+
+/// Processors of every thread of the sim, called by the main thread before it
+/// launches the other threads
+void thread_affinity_t::plan()
+{
+  mode = NONE;
+  assignment.clear();
+
+  if ( util::str_compare_ci( mode_str, "core" ) )
+    mode = CORE;
+  else if ( util::str_compare_ci( mode_str, "socket" ) )
+    mode = SOCKET;
+  else if ( ! mode_str.empty() && ! util::str_compare_ci( mode_str, "none" ) && ! sim -> parent )
+    sim -> errorf( "Unknown thread_affinity '%s', threads are not bound.\n", mode_str.c_str() );
+
+  if ( ! placement_str.empty() && ! util::str_compare_ci( placement_str, "spread" ) &&
+       ! util::str_compare_ci( placement_str, "compact" ) && ! sim -> parent )
+    sim -> errorf( "Unknown thread_placement '%s', using spread.\n", placement_str.c_str() );
+
+  // The topology also names the nodes in the thread summary of report_timing
+  if ( mode != NONE || sim -> timing -> report )
+    topology = computer_process::cpu_topology();
+
+  if ( mode == NONE )
+    return;
+
+  if ( topology.empty() )
+  {
+    if ( ! sim -> parent )
+      sim -> errorf( "thread_affinity is not supported on this platform, threads are not bound.\n" );
+    mode = NONE;
+    return;
+  }
+
+  int threads = std::max( sim -> threads, 1 );
+  if ( mode == CORE && static_cast<size_t>( threads ) > topology.size() && ! sim -> parent )
+  {
+    sim -> errorf( "thread_affinity=core with %d threads on %u processors, threads share processors.\n",
+                   threads, static_cast<unsigned>( topology.size() ) );
+  }
+
+  std::vector<unsigned> order = processor_order();
+  for ( int i = 0; i < threads; ++i )
+  {
+    const computer_process::cpu_t& cpu = topology[ order[ i % order.size() ] ];
+    std::vector<unsigned> processors;
+    for ( const auto& c : topology )
+    {
+      if ( mode == CORE ? c.id == cpu.id : c.socket == cpu.socket )
+        processors.push_back( c.id );
+    }
+    assignment.push_back( processors );
+  }
+}
+
+// thread_affinity_t::processor_order =======================================
+
+/// Order in which threads take processors, as indices into the topology. The
+/// physical cores of a node come before their SMT siblings, and the nodes are
+/// either filled one after the other (compact) or taken in turns (spread).
+std::vector<unsigned> thread_affinity_t::processor_order() const
+{
+  // SMT rank: processors of the same core with a lower id
+  std::vector<unsigned> rank( topology.size() );
+  for ( size_t i = 0; i < topology.size(); ++i )
+  {
+    for ( const auto& c : topology )
+    {
+      if ( c.socket == topology[ i ].socket && c.core == topology[ i ].core && c.id < topology[ i ].id )
+        ++rank[ i ];
+    }
+  }
+
+  std::vector<unsigned> order( topology.size() );
+  for ( size_t i = 0; i < order.size(); ++i )
+    order[ i ] = static_cast<unsigned>( i );
+
+  range::sort( order, [ this, &rank ]( unsigned a, unsigned b ) {
+    const computer_process::cpu_t& x = topology[ a ];
+    const computer_process::cpu_t& y = topology[ b ];
+    if ( x.node != y.node )
+      return x.node < y.node;
+    if ( rank[ a ] != rank[ b ] )
+      return rank[ a ] < rank[ b ];
+    if ( x.socket != y.socket )
+      return x.socket < y.socket;
+    if ( x.core != y.core )
+      return x.core < y.core;
+    return x.id < y.id;
+  } );
+
+  if ( util::str_compare_ci( placement_str, "compact" ) )
+    return order;
+
+  std::map<unsigned, std::vector<unsigned>> nodes;
+  for ( auto i : order )
+    nodes[ topology[ i ].node ].push_back( i );
+
+  std::vector<unsigned> spread;
+  for ( size_t k = 0; spread.size() < order.size(); ++k )
+  {
+    for ( const auto& node : nodes )
+    {
+      if ( k < node.second.size() )
+        spread.push_back( node.second[ k ] );
+    }
+  }
+
+  return spread;
+}
+
+// thread_affinity_t::root ==================================================
+
+/// Threads of a sim are placed by the main thread of the sim
+const thread_affinity_t* thread_affinity_t::root() const
+{
+  return sim -> thread_root() -> affinity.get();
+}
+
+// thread_affinity_t::pin ===================================================
+
+/// Bind the calling thread to its processors, before its sim is initialized
+void thread_affinity_t::pin()
+{
+  const thread_affinity_t* r = root();
+
+  pinned = false;
+  if ( static_cast<size_t>( sim -> thread_index ) >= r -> assignment.size() )
+    return;
+
+  pinned = computer_process::set_thread_affinity( r -> assignment[ sim -> thread_index ] );
+  if ( ! pinned )
+    sim -> errorf( "Unable to set the processor affinity of thread %d.\n", sim -> thread_index );
+}
+
+// thread_affinity_t::placement =============================================
+
+/// Processor and node of the calling thread, at the end of sim_t::iterate()
+void thread_affinity_t::placement( phase_timing_t::thread_t& thread ) const
+{
+  thread.processor = computer_process::current_cpu();
+  thread.node = -1;
+  thread.pinned = pinned;
+
+  for ( const auto& cpu : root() -> topology )
+  {
+    if ( static_cast<int>( cpu.id ) == thread.processor )
+      thread.node = static_cast<int>( cpu.node );
+  }
+}
+
+// thread_affinity_t::create_options ========================================
+
+void thread_affinity_t::create_options()
+{
+  sim -> add_option( opt_string( "thread_affinity", mode_str ) );
+  sim -> add_option( opt_string( "thread_placement", placement_str ) );
+}
@@ -73,6 +73,8 @@ struct attack_t;
 struct benefit_t;
 struct buff_t;
 struct callback_t;
+struct checkpoint_t;
+struct comparison_t;
 struct cooldown_t;
 struct cost_reduction_buff_t;
 class dbc_t;
@@ -84,14 +86,19 @@ struct gain_t;
 struct haste_buff_t;
 struct heal_t;
 struct item_t;
+struct iteration_export_t;
 struct instant_absorb_t;
+struct memory_report_t;
 struct module_t;
 struct pet_t;
+struct pet_pool_base_t;
+struct phase_timing_t;
 struct player_t;
 struct plot_t;
 struct proc_t;
 struct reforge_plot_t;
 struct scaling_t;
+struct shard_t;
 struct sim_t;
 struct special_effect_t;
 struct spell_data_t;
@@ -101,6 +108,7 @@ struct spell_t;
 struct stats_t;
 struct stat_buff_t;
 struct stat_pair_t;
+struct thread_affinity_t;
 struct travel_event_t;
 struct xml_node_t;
 class xml_writer_t;
@@ -126,6 +134,12 @@ namespace highchart {
 // Timeline
 #include "util/timeline.hpp"
 
+// Binary serialization of mergeable state
+#include "util/serialize.hpp"
+
+// Interned names for actor registries
+#include "util/symbol_table.hpp"
+
 // Random Number Generators
 #include "util/rng.hpp"
 
@@ -562,8 +576,18 @@ struct uptime_t : public uptime_common_t
 
 struct buff_uptime_t : public uptime_common_t
 {
+  // Iterations that ended with this stack level as the highest one reached in the simulation so
+  // far. With sim option sparse_buff_data, buff_t::analyze() derives the sample counts from these.
+  size_t max_stack_iterations;
+
   buff_uptime_t() :
-    uptime_common_t() {}
+    uptime_common_t(), max_stack_iterations( 0 ) {}
+
+  void merge( const buff_uptime_t& other )
+  {
+    uptime_common_t::merge( other );
+    max_stack_iterations += other.max_stack_iterations;
+  }
 };
 
 using buff_tick_callback_t = std::function<void(buff_t*, int, const timespan_t&)>;
@@ -866,6 +890,7 @@ protected:
   unsigned int overflow_count, overflow_total;
   int trigger_attempts, trigger_successes;
   int simulation_max_stack;
+  int iteration_max_stack; // Highest stack reached since the last datacollection_begin()
   std::vector<cache_e> invalidate_list;
 
   // report data
@@ -1009,6 +1034,7 @@ public:
   static buff_t* find(    sim_t*, const std::string& name );
   static buff_t* find( player_t*, const std::string& name, player_t* source = nullptr );
   static buff_t* find_expressable( const std::vector<buff_t*>&, const std::string& name, player_t* source = nullptr );
+  static buff_t* find_expressable( player_t*, const std::string& name, player_t* source = nullptr );
 
   const char* name() const { return name_str.c_str(); }
   std::string source_name() const;
@@ -1281,7 +1307,7 @@ struct progress_bar_t
 
 /* Encapsulated Vector
  * const read access
- * Modifying the vector triggers registered callbacks
+ * Modifying the vector triggers registered callbacks, and increments the version of the vector
  */
 template <typename T>
 struct vector_with_callback
@@ -1289,6 +1315,7 @@ struct vector_with_callback
 private:
   std::vector<T> _data;
   std::vector<std::function<void(T)> > _callbacks ;
+  mutable unsigned _version = 0;
 public:
   /* Register your custom callback, which will be called when the vector is modified
    */
@@ -1311,6 +1338,7 @@ public:
 
   void trigger_callbacks(T v) const
   {
+    ++_version;
     for ( size_t i = 0; i < _callbacks.size(); ++i )
       _callbacks[i](v);
   }
@@ -1348,6 +1376,10 @@ public:
   bool empty() const
   { return _data.empty(); }
 
+  // Number of modifications so far, allows users to detect changes without a callback
+  unsigned version() const
+  { return _version; }
+
 private:
   void erase_unordered( typename std::vector<T>::iterator it )
   {
@@ -1451,7 +1483,9 @@ struct event_manager_t
  ~event_manager_t();
   void* allocate_event( std::size_t size );
   void recycle_event( event_t* );
+  unsigned assign_event_time( timespan_t delta_time, timespan_t& time, timespan_t& reschedule_time );
   void add_event( event_t*, timespan_t delta_time );
+  void insert_event( event_t* );
   void reschedule_event( event_t* );
   event_t* next_event();
   bool execute();
@@ -1462,6 +1496,91 @@ struct event_manager_t
   void merge( event_manager_t& other );
 };
 
+// Spatial Grid =============================================================
+
+/* Uniform grid of actor positions for distance targeting. A query marks every actor that may be
+ * within the given distance of a point, plus its combat reach, so range and radius checks only
+ * need exact distances for the actors near the point.
+ */
+struct spatial_grid_t
+{
+  spatial_grid_t( double cell_size = 10.0 );
+
+  void update( player_t* );
+
+  void mark( double x, double y, double distance ) const;
+  bool marked( const player_t* ) const;
+private:
+  typedef std::vector<player_t*> cell_t;
+
+  double cell_size;
+  double max_combat_reach;
+  std::vector<player_t*> actors;
+  std::vector<uint64_t> actor_cell;
+  std::vector<bool> in_grid;
+  std::unordered_map<uint64_t, cell_t> cells;
+  mutable std::vector<unsigned> stamp;
+  mutable unsigned current_stamp;
+
+  int64_t cell_coord( double v ) const
+  { return static_cast<int64_t>( std::floor( v / cell_size ) ); }
+  static uint64_t cell_key( int64_t x, int64_t y )
+  { return ( static_cast<uint64_t>( static_cast<uint32_t>( x ) ) << 32 ) | static_cast<uint32_t>( y ); }
+};
+
+// DoT Tick Scheduler =======================================================
+
+/* A scheduled DoT tick. Ticks are not events of their own, but entries in the tick scheduler of
+ * the source actor of the DoT. Each entry is given the time and id the tick event would have had in
+ * the timing wheel, and mirrors the parts of the event interface used for DoT ticks.
+ */
+struct dot_tick_t
+{
+  dot_t* dot;
+  timespan_t time;
+  timespan_t reschedule_time;
+  unsigned id;
+  size_t heap_index;
+
+  dot_tick_t( dot_t* d ) :
+    dot( d ), time( timespan_t::zero() ), reschedule_time( timespan_t::zero() ), id( 0 ), heap_index( 0 )
+  { }
+
+  timespan_t occurs() const
+  { return ( reschedule_time != timespan_t::zero() ) ? reschedule_time : time; }
+  timespan_t remains() const;
+  void reschedule( timespan_t delta_time );
+};
+
+/* Per-actor DoT tick scheduler. The pending ticks of all DoTs of an actor are kept in a heap
+ * ordered by ( time, id ), and a single event is placed in the timing wheel for the earliest one.
+ * The event is inserted with the time and id of the tick it executes, so ticks execute in exactly
+ * the same order relative to other events as individually scheduled tick events would.
+ */
+struct dot_tick_scheduler_t
+{
+  dot_tick_scheduler_t( player_t* p );
+
+  void schedule( dot_t*, timespan_t delta_time );
+  void cancel( dot_t* );
+  void execute();
+  void reset();
+private:
+  player_t* player;
+  std::vector<dot_tick_t*> heap;
+  event_t* event;
+  bool executing;
+
+  static bool before( const dot_tick_t* l, const dot_tick_t* r )
+  { return l -> time < r -> time || ( l -> time == r -> time && l -> id < r -> id ); }
+  void push( dot_tick_t* );
+  void remove( dot_tick_t* );
+  void sift_up( size_t idx );
+  void sift_down( size_t idx );
+  void place( size_t idx, dot_tick_t* );
+  void update_event();
+};
+
 // Simulation Engine ========================================================
 
 struct sim_t : private sc_thread_t
@@ -1518,9 +1637,14 @@ struct sim_t : private sc_thread_t
   timespan_t  reaction_time, regen_periodicity;
   timespan_t  ignite_sampling_delta;
   bool        fixed_time, optimize_expressions;
+  bool        sparse_timelines; // Record resource and stat timelines on change instead of periodically
+  bool        sparse_buff_data; // Only sample buffs (and stack levels) that were up or triggered in an iteration
+  bool        init_timing; // Report the initialization time of each actor
   int         current_slot;
   int         optimal_raid, log, debug_each;
   std::vector<uint64_t> debug_seed;
+  std::vector<int> sequence_iterations; // Iterations of the main thread to record action sequences on
+  bool        record_sequence; // Current iteration records action sequences
   int         save_profiles, default_actions;
   stat_e      normalized_stat;
   std::string current_name, default_region_str, default_server_str, save_prefix_str, save_suffix_str;
@@ -1581,6 +1705,10 @@ struct sim_t : private sc_thread_t
   std::string rng_str;
   uint64_t seed;
   int deterministic;
+  // Every iteration seeds the rng from ( seed, global iteration number ), see
+  // sim_t::seed_iteration(). global_iteration is -1 in the warm-up iteration.
+  int deterministic_iterations;
+  int global_iteration;
   int average_range, average_gauss;
   int convergence_scale;
 
@@ -1616,6 +1744,13 @@ struct sim_t : private sc_thread_t
   std::unique_ptr<scaling_t> scaling;
   std::unique_ptr<plot_t> plot;
   std::unique_ptr<reforge_plot_t> reforge_plot;
+  std::unique_ptr<checkpoint_t> checkpoint;
+  std::unique_ptr<shard_t> shard;
+  std::unique_ptr<iteration_export_t> iteration_export;
+  std::unique_ptr<phase_timing_t> timing;
+  std::unique_ptr<comparison_t> comparison;
+  std::unique_ptr<thread_affinity_t> affinity;
+  std::unique_ptr<memory_report_t> memory;
   double elapsed_cpu;
   double elapsed_time;
   double     iteration_dmg, priority_iteration_dmg,  iteration_heal, iteration_absorb;
@@ -1644,12 +1779,13 @@ struct sim_t : private sc_thread_t
   std::vector<player_t*> targets_by_name;
   std::vector<std::string> id_dictionary;
   std::map<double, std::vector<double> > divisor_timeline_cache;
-  std::string output_file_str, html_file_str, json_file_str, json2_file_str;
+  std::string output_file_str, html_file_str, json_file_str, json2_file_str, bench_file_str;
   std::string xml_file_str, xml_stylesheet_file_str;
   std::string reforge_plot_output_file_str;
   std::vector<std::string> error_list;
   int report_precision;
   int report_pets_separately;
+  bool full_add_data_collection;
   int report_targets;
   int report_details;
   int report_raw_abilities;
@@ -1671,6 +1807,7 @@ struct sim_t : private sc_thread_t
   bool maximize_reporting;
   std::string apikey;
   bool distance_targeting_enabled;
+  spatial_grid_t actor_grid;
   bool enable_dps_healing;
   double scaling_normalized;
 
@@ -1679,6 +1816,9 @@ struct sim_t : private sc_thread_t
   int threads;
   std::vector<sim_t*> children; // Manual delete!
   int thread_index;
+  // Main thread of this sim, the sim itself unless it is a thread sim
+  sim_t* thread_root() const
+  { return thread_index > 0 ? parent : const_cast<sim_t*>( this ); }
   computer_process::priority_e process_priority;
   struct sim_progress_t
   {
@@ -1694,8 +1834,9 @@ struct sim_t : private sc_thread_t
     public:
     std::vector<int> _total_work, _work, _projected_work;
     size_t index;
+    int _claimed;
 
-    work_queue_t() : index( 0 )
+    work_queue_t() : index( 0 ), _claimed( 0 )
     { _total_work.resize( 1 ); _work.resize( 1 ); _projected_work.resize( 1 ); }
 
     void init( int w )    { AUTO_LOCK(m); range::fill( _total_work, w ); range::fill( _projected_work, w ); }
@@ -1705,6 +1846,19 @@ struct sim_t : private sc_thread_t
     void flush()          { AUTO_LOCK(m); _total_work[ index ] = _projected_work[ index ] = _work[ index ]; }
     void project( int w ) { AUTO_LOCK(m); _projected_work[ index ] = w; assert( w >= _work[ index ] ); }
     int  size()           { AUTO_LOCK(m); return _total_work[ index ]; }
+    // Mark w units of work as already done (checkpoint resume)
+    void skip( int w )    { AUTO_LOCK(m); _claimed = _work[ index ] = std::min( w, _total_work[ index ] ); }
+
+    // Number of the next unit of work, -1 once all work has been handed out. Only used
+    // with deterministic_iterations, which does not support single actor batch mode.
+    int claim()
+    {
+      AUTO_LOCK(m);
+      if ( index >= _total_work.size() || _claimed >= _total_work[ index ] )
+        return -1;
+
+      return _claimed++;
+    }
 
     // Single-actor batch pop, uses several indices of work (per active actor), each thread has it's
     // own state on what index it is simulating
@@ -1760,21 +1914,36 @@ struct sim_t : private sc_thread_t
 
   // Spell database access
   std::unique_ptr<spell_data_expr_t> spell_query;
+  std::string        spell_query_str;
   unsigned           spell_query_level;
   std::string        spell_query_xml_output_file_str;
+  std::string        spell_query_file_str;
 
   mutex_t* pause_mutex; // External pause mutex, instantiated an external entity (in our case the GUI).
   bool paused;
 
   // Highcharts stuff
 
-  // Vector of on-ready charts. These receive individual jQuery handlers in the HTML report (at the
-  // end of the report) to load the highcharts into the target div.
-  std::vector<std::string> on_ready_chart_data;
+  // Unique highcharts series data (as JSON) of all charts in the HTML report. Chart options refer
+  // to their series data by index, so identical series are written into the report only once,
+  // regardless of the title, id or axes of the charts. The strings are owned by chart_series_index.
+  std::vector<const std::string*> chart_series;
+  std::unordered_map<std::string, size_t> chart_series_index;
 
-  // A map of highcharts data, added as a json object into the HTML report. JQuery installs handlers
-  // to correct elements (toggled elements in the HTML report) based on the data.
-  std::map<std::string, std::vector<std::string> > chart_data;
+  // Unique highcharts options (as JSON, without series data) of all charts in the HTML report.
+  // Charts refer to their options by index, so identical charts are written into the report only
+  // once. The strings are owned by chart_options_index.
+  std::vector<const std::string*> chart_options;
+  std::unordered_map<std::string, size_t> chart_options_index;
+
+  // Vector of on-ready charts (target div, options index). These are loaded by a jQuery handler in
+  // the HTML report (at the end of the report) into the target div.
+  std::vector<std::pair<std::string, size_t> > on_ready_chart_data;
+
+  // A map of highcharts data (target div, options index) per toggle element, added as a json object
+  // into the HTML report. JQuery installs handlers to correct elements (toggled elements in the HTML
+  // report) based on the data.
+  std::map<std::string, std::vector<std::pair<std::string, size_t> > > chart_data;
 
   bool chart_show_relative_difference;
   double chart_boxplot_percentile;
@@ -1810,11 +1979,13 @@ struct sim_t : private sc_thread_t
   bool      init_actors();
   bool      init_actor( player_t* );
   bool      init_actor_pets();
+  void      print_init_timing() const;
   bool      init();
   void      analyze();
   void      merge( sim_t& other_sim );
   void      merge();
   bool      iterate();
+  bool      seed_iteration();
   void      partition();
   bool      execute();
   void      analyze_error();
@@ -1853,6 +2024,7 @@ struct sim_t : private sc_thread_t
 private:
   void do_pause();
   void print_spell_query();
+  void print_spell_query_file();
   void enable_debug_seed();
   void disable_debug_seed();
 };
@@ -2032,6 +2204,361 @@ private:
   void create_options();
 };
 
+// Checkpoint ===============================================================
+
+/* Periodic checkpointing of the baseline simulation.
+ *
+ * Every thread sim serializes its accumulated data collection state at an
+ * iteration boundary once per checkpoint_interval seconds (wall clock), and
+ * the main thread writes the latest state of all threads to checkpoint_file.
+ * With checkpoint_resume=1, a later run skips the iterations the stored state
+ * covers, merges it into the main sim after its first iteration, and continues
+ * with fresh RNG streams.
+ */
+struct checkpoint_t
+{
+  sim_t* sim;
+  std::string file_str;
+  double interval;
+  bool resume;
+
+  checkpoint_t( sim_t* s );
+
+  bool start();
+  void iteration_end( bool force = false );
+  void finish();
+
+  int restored_iterations() const
+  { return restored; }
+  uint64_t seed_offset() const;
+
+  static std::string save_state( sim_t& );
+  static void merge_state( sim_t&, const std::string& );
+private:
+  mutex_t mutex;
+  std::vector<std::string> thread_state;
+  std::vector<int> thread_iterations;
+  std::vector<std::string> restored_state;
+  int requested, restored;
+  unsigned generation;
+  double next_update;
+  bool restore_failed;
+
+  sim_t* root() const;
+  void restore();
+  void update( sim_t& );
+  void write();
+  void create_options();
+};
+
+// Shard ====================================================================
+
+/* Sharded simulation across independent processes.
+ *
+ * shard=i/N runs the i-th of N slices of the baseline iterations with a seed
+ * derived from the shard index, and writes the mergeable sim state to
+ * shard_output instead of analyzing and reporting it. shard_merge=a,b,...
+ * folds shard files produced from the same input into the main sim, then
+ * analyzes and reports the combined result. Shard data of objects that do not
+ * exist in the merging sim fails the merge instead of being dropped.
+ */
+struct shard_t
+{
+  sim_t* sim;
+  unsigned index, count;
+  std::string output_file_str;
+  std::string merge_file_str;
+
+  shard_t( sim_t* s );
+
+  bool enabled() const
+  { return count > 0 && ! sim -> parent; }
+  bool merging() const
+  { return ! merge_file_str.empty() && ! sim -> parent; }
+
+  void setup();
+  bool write();
+  bool merge();
+private:
+  void create_options();
+};
+
+// Iteration Data Export ====================================================
+
+/* Streaming per-iteration data export of the baseline simulation.
+ *
+ * Every thread buffers one row per iteration (fight length, raid dps, and
+ * per player dps, deaths and action amounts) in columns, and appends them as
+ * a self-describing chunk to its own part file once the chunk is full. The
+ * main thread concatenates the part files into iteration_data_file at the
+ * end. util_scripts/read_iteration_data.py reads the format.
+ */
+struct iteration_export_t
+{
+  sim_t* sim;
+  std::string file_str;
+
+  iteration_export_t( sim_t* s );
+
+  void start();
+  void add_row();
+  void finish_thread();
+  void finish();
+private:
+  enum column_e
+  {
+    COLUMN_ITERATION,
+    COLUMN_FIGHT_LENGTH,
+    COLUMN_RAID_DPS,
+    COLUMN_PLAYER_DPS,
+    COLUMN_PLAYER_DEATHS,
+    COLUMN_ACTION_AMOUNT
+  };
+
+  struct column_t
+  {
+    std::string name;
+    column_e type;
+    const player_t* player;
+    const stats_t* stats;
+    size_t last_count;
+    std::vector<double> values;
+  };
+
+  bool active;
+  size_t rows;
+  std::vector<column_t> columns;
+  io::ofstream out;
+
+  std::string part_file( int thread_index ) const;
+  void build_columns();
+  void write_chunk();
+  void create_options();
+};
+
+// Phase Timing =============================================================
+
+/* Wall clock and CPU time per phase of a simulation run (option parsing,
+ * init, thread launch, iterations, merge, analyze, each report writer, ...),
+ * and the utilization of every thread of the baseline simulation. Child
+ * threads report into their parent at the end of sim_t::run(). The data is
+ * part of the JSON report; report_timing=1 also prints a text summary once all
+ * reports are written.
+ */
+struct phase_timing_t
+{
+  struct phase_t
+  {
+    std::string name;
+    double wall, cpu;
+  };
+
+  // Wall clock seconds, except cpu (CPU time of the thread)
+  struct thread_t
+  {
+    int index;
+    int iterations;
+    double init, run, merge, cpu;
+    double finish; // Process wall time when the thread ran out of work
+    double idle;   // Waiting for the slowest thread, see finish_threads()
+    int processor; // Logical processor at the end of the run, -1 if unknown
+    int node;      // NUMA node of the processor, -1 if unknown
+    bool pinned;   // Bound to processors by thread_affinity
+  };
+
+  // Records a phase from construction to destruction
+  struct scope_t
+  {
+    phase_timing_t& timing;
+    const char* name;
+    double wall, cpu;
+
+    scope_t( phase_timing_t& t, const char* n );
+    ~scope_t();
+  };
+
+  sim_t* sim;
+  bool report;
+  std::vector<phase_t> phases;
+  std::vector<thread_t> threads;
+  thread_t own; // This sim's thread, filled in by sim_t::iterate()
+
+  phase_timing_t( sim_t* s );
+
+  void add_phase( const std::string& name, double wall, double cpu );
+  void add_thread( const thread_t& );
+  void finish_threads();
+  double wall( const std::string& prefix ) const;
+  void print() const;
+private:
+  mutex_t mutex;
+  void create_options();
+};
+
+// Thread Affinity ==========================================================
+
+/* Placement of the threads of a simulation on the processors of the machine.
+ * With thread_affinity=core every thread is bound to one logical processor,
+ * with thread_affinity=socket to all processors of a socket. The order in which
+ * threads take processors is set by thread_placement: spread (default)
+ * alternates between NUMA nodes, compact fills a node before the next one.
+ * Both use the physical cores of a node before their SMT siblings. Threads bind
+ * themselves before they initialize their sim, so the actions, buffs, stats
+ * and events they allocate are first touched on their own node.
+ */
+struct thread_affinity_t
+{
+  enum mode_e { NONE, CORE, SOCKET };
+
+  sim_t* sim;
+  std::string mode_str;
+  std::string placement_str;
+  mode_e mode;
+  bool pinned;
+  std::vector<computer_process::cpu_t> topology;
+  std::vector<std::vector<unsigned>> assignment; // Processors of every thread
+
+  thread_affinity_t( sim_t* s );
+
+  void plan();
+  void pin();
+  void placement( phase_timing_t::thread_t& ) const;
+private:
+  const thread_affinity_t* root() const;
+  std::vector<unsigned> processor_order() const;
+  void create_options();
+};
+
+// Memory Accounting ========================================================
+
+/* Bytes held by the data containers of a simulation, attributed to actors
+ * (pets count towards their owner) and subsystems: sample data, timelines,
+ * buff uptimes, action sequences, cached action states, events, and report
+ * data. Container capacities are counted, not the objects themselves, so the
+ * totals are a lower bound of the memory use. With report_memory=1 the merged
+ * sim is accounted after the reports are written, and every thread accounts
+ * its own data when it runs out of work (the child sims, before they merge).
+ * report_memory_interval=n additionally prints the total of all threads every n
+ * iterations.
+ */
+struct memory_report_t
+{
+  enum category_e
+  {
+    MEMORY_SAMPLES = 0,
+    MEMORY_TIMELINES,
+    MEMORY_BUFFS,
+    MEMORY_SEQUENCES,
+    MEMORY_STATES,
+    MEMORY_EVENTS,
+    MEMORY_REPORTS,
+    MEMORY_MAX
+  };
+
+  typedef std::array<size_t, MEMORY_MAX> usage_t;
+
+  struct actor_t
+  {
+    std::string name;
+    usage_t usage;
+  };
+
+  sim_t* sim;
+  bool report;
+  int interval;
+  std::vector<actor_t> actors;
+  usage_t sim_usage;             // Not attributed to an actor
+  std::vector<usage_t> threads;  // Latest accounting of every thread
+
+  memory_report_t( sim_t* s );
+
+  static const char* category_string( category_e );
+  static size_t total( const usage_t& );
+
+  void iteration_end();
+  void finish_thread();
+  void finish();
+  void print() const;
+private:
+  mutex_t mutex;
+  memory_report_t* root() const;
+  void account_actor( const player_t&, usage_t& ) const;
+  void account_sim( usage_t& ) const;
+  usage_t account_thread() const;
+  void add_thread( int thread_index, const usage_t& );
+  void create_options();
+};
+
+// Variant Comparison =======================================================
+
+/* Sequential early stopping for comparisons of actors simulated side by side.
+ *
+ * With comparison_confidence=c, every iteration records the target metric
+ * (dps, hps or tmi, by role) of the compared actors (comparison_actors, all
+ * players by default), and the paired difference of every pair of them.
+ * sim_t::analyze_error stops the simulation as soon as every pair of actors
+ * adjacent in the ranking is either separated at confidence c, or their
+ * difference is shown to be within comparison_threshold percent of their mean.
+ * It replaces target_error as the stopping rule. The error probability is split
+ * over the pairs and over the repeated checks, so the final decision holds at
+ * confidence c.
+ */
+struct comparison_t
+{
+  enum verdict_e { UNRESOLVED, RANKED, EQUIVALENT };
+
+  // Running mean and variance of the paired difference first - second
+  struct pair_t
+  {
+    size_t first, second;
+    double mean, m2;
+  };
+
+  // Actor in the ranking, and its comparison to the next actor
+  struct result_t
+  {
+    size_t actor;
+    double mean;
+    double difference, half_width; // Confidence interval of the difference to the next actor
+    verdict_e verdict;
+  };
+
+  sim_t* sim;
+  double confidence;
+  double threshold;
+  std::string actors_str;
+  std::vector<player_t*> actors;
+
+  // Collected data of all threads, in the main thread of the sim
+  size_t count;
+  std::vector<double> sum;
+  std::vector<pair_t> pairs;
+  unsigned checks;
+  int settled_iterations; // Iterations when the comparison was settled, 0 if it was not
+  std::vector<result_t> results;
+
+  comparison_t( sim_t* s );
+
+  bool enabled() const
+  { return confidence > 0; }
+
+  static const char* verdict_string( verdict_e );
+
+  void init();
+  void collect();
+  bool analyze();
+  void finish();
+  void print() const;
+private:
+  mutex_t mutex;
+
+  comparison_t* root() const;
+  void add( const std::vector<double>& values );
+  double critical_value() const;
+  bool evaluate( double z );
+  void create_options();
+};
+
 struct plot_data_t
 {
   double plot_step;
@@ -2951,6 +3478,8 @@ struct cooldown_t
   double recharge_multiplier;
   bool hasted; // Hasted cooldowns will reschedule based on haste state changing (through buffs). TODO: Separate hastes?
   action_t* action; // Dynamic cooldowns will need to know what action triggered the cd
+  int dynamic_index; // Position in the player's dynamic cooldown list, -1 for non-dynamic cooldowns
+  bool dynamic_running; // Dynamic cooldown is in the player's running dynamic cooldown list
 
   cooldown_t( const std::string& name, player_t& );
   cooldown_t( const std::string& name, sim_t& );
@@ -3020,8 +3549,30 @@ struct effect_callbacks_t
 
   proc_array_t procs;
 
+  // Prefiltered dispatch. For each (proc_types, proc_types2) pair, a dense array of records that
+  // carry the non-virtual gating state of the callback (proc cooldown, required weapon). Dispatch
+  // checks the records inline, so only callbacks that can actually fire reach trigger().
+  struct dispatch_entry_t
+  {
+    T_CB* cb;
+    const cooldown_t* cooldown;
+    const weapon_t* weapon;
+
+    dispatch_entry_t( T_CB* c ) :
+      cb( c ), cooldown( c -> dispatch_cooldown() ), weapon( c -> dispatch_weapon() )
+    { }
+  };
+
+  typedef std::vector<dispatch_entry_t> dispatch_list_t;
+  typedef std::array<dispatch_list_t, PROC2_TYPE_MAX> dispatch_on_array_t;
+  typedef std::array<dispatch_on_array_t, PROC1_TYPE_MAX> dispatch_array_t;
+
+  dispatch_array_t dispatch;
+  // Bitmask of proc_types2 that have at least one callback registered, for each proc_types
+  std::array<unsigned, PROC1_TYPE_MAX> dispatch_mask;
+
   effect_callbacks_t( sim_t* sim ) : sim( sim )
-  { }
+  { dispatch_mask.fill( 0 ); }
 
   virtual ~effect_callbacks_t()
   { range::sort( all_callbacks ); dispose( all_callbacks.begin(), range::unique( all_callbacks ) ); }
@@ -3029,8 +3580,15 @@ struct effect_callbacks_t
   void reset();
 
   void register_callback( unsigned proc_flags, unsigned proc_flags2, T_CB* cb );
+
+  bool has_callbacks( proc_types type, proc_types2 type2 ) const
+  { return ( dispatch_mask[ type ] & ( 1U << type2 ) ) != 0; }
+
+  // Trigger all callbacks registered to ( type, type2 )
+  void trigger( proc_types type, proc_types2 type2, action_t* a, action_state_t* state ) const;
 private:
   void add_proc_callback( proc_types type, unsigned flags, T_CB* cb );
+  void add_callback( proc_types type, proc_types2 type2, T_CB* cb );
 };
 
 // Stat Cache
@@ -3056,32 +3614,30 @@ private:
  * To create invalidation chains ( eg. Priest: Spirit invalidates Hit ) override the
  * virtual player_t::invalidate_cache( cache_e ) function.
  *
- * Attention: player_t::invalidate_cache( cache_e ) is recursive and may call itself again.
+ * The base invalidation chains of player_t are precomputed into a transitive mask per cache
+ * entry, and invalidated with a single masked operation. Class modules that need to react to an
+ * indirectly invalidated entry ( eg. Attack Power through Strength ) have to add it to
+ * player_t::cache_invalidation_notify, after which player_t::invalidate_cache( cache_e ) will be
+ * called for it.
  */
 struct player_stat_cache_t
 {
+  typedef std::bitset<CACHE_MAX> mask_t;
+
   const player_t* player;
-  mutable std::array<bool, CACHE_MAX> valid;
-  mutable std::array < bool, SCHOOL_MAX + 1 > spell_power_valid, player_mult_valid, player_heal_mult_valid;
   // 'valid'-states
+  mutable mask_t valid;
+  mutable std::bitset<SCHOOL_MAX + 1> spell_power_valid, player_mult_valid, player_heal_mult_valid;
 private:
-  // cached values
-  mutable double _strength, _agility, _stamina, _intellect, _spirit;
-  mutable double _spell_power[SCHOOL_MAX + 1], _attack_power;
-  mutable double _attack_expertise;
-  mutable double _attack_hit, _spell_hit;
-  mutable double _attack_crit_chance, _spell_crit_chance;
-  mutable double _attack_haste, _spell_haste;
-  mutable double _attack_speed, _spell_speed;
-  mutable double _dodge, _parry, _block, _crit_block, _armor, _bonus_armor;
-  mutable double _mastery, _mastery_value, _crit_avoidance, _miss;
-  mutable double _player_mult[SCHOOL_MAX + 1], _player_heal_mult[SCHOOL_MAX + 1];
-  mutable double _damage_versatility, _heal_versatility, _mitigation_versatility;
-  mutable double _leech, _run_speed, _avoidance;
+  // cached values, indexed by cache_e / school_e
+  mutable std::array<double, CACHE_MAX> _value;
+  mutable std::array<double, SCHOOL_MAX + 1> _spell_power, _player_mult, _player_heal_mult;
+  mutable double _mastery_value;
 public:
   bool active; // runtime active-flag
   void invalidate_all();
   void invalidate( cache_e );
+  void invalidate( const mask_t& );
   double get_attribute( attribute_e ) const;
   player_stat_cache_t( const player_t* p ) : player( p ), active( false ) { invalidate_all(); }
 #if defined(SC_USE_STAT_CACHE)
@@ -3172,6 +3728,80 @@ struct player_processed_report_information_t
 
 };
 
+// Action Sequence ==========================================================
+
+/* Columnar recorder for the action sequence of one or more iterations. Entries are fixed-size
+ * records stored contiguously. Buff and resource snapshots are [begin, end) ranges into shared
+ * buffers, and an entry whose buff snapshot equals the previous entry's reuses the previous
+ * range. Once the buffers have been reserved, recording an entry does not allocate.
+ */
+struct action_sequence_t
+{
+  struct buff_snapshot_t
+  {
+    buff_t* buff;
+    int stacks;
+  };
+
+  struct resource_snapshot_t
+  {
+    resource_e resource;
+    double current, max;
+  };
+
+  struct entry_t
+  {
+    const action_t* action; // nullptr for waiting
+    const player_t* target;
+    timespan_t time;
+    timespan_t wait_time;
+    unsigned buff_begin, buff_end;
+    unsigned resource_begin, resource_end;
+    bool precombat;
+  };
+
+  // A contiguous run of entries recorded on one iteration
+  struct iteration_t
+  {
+    int iteration;
+    size_t begin, end;
+  };
+
+  std::vector<entry_t> entries;
+  std::vector<buff_snapshot_t> buffs;
+  std::vector<resource_snapshot_t> resources;
+  std::vector<iteration_t> iterations;
+
+  void reserve( size_t n_entries );
+  void clear();
+
+  // Add an action (or, with a nullptr action, a wait) to the sequence of the given iteration
+  entry_t& add( int iteration, const action_t* a, const player_t* target, const timespan_t& time,
+                const timespan_t& wait_time, const player_t* p );
+
+  bool empty() const
+  { return entries.empty(); }
+
+  // Number of entries recorded on the current (last) iteration
+  size_t current_size() const
+  { return iterations.empty() ? 0 : iterations.back().end - iterations.back().begin; }
+
+  // Snapshotted resource values of an entry, or -1 if the resource was not active
+  double resource( const entry_t& e, resource_e r ) const;
+  double resource_max( const entry_t& e, resource_e r ) const;
+
+  const buff_snapshot_t* buffs_begin( const entry_t& e ) const
+  { return buffs.data() + e.buff_begin; }
+  const buff_snapshot_t* buffs_end( const entry_t& e ) const
+  { return buffs.data() + e.buff_end; }
+
+  // Entries of the first recorded iteration, used by reports
+  const entry_t* begin() const
+  { return iterations.empty() ? entries.data() : entries.data() + iterations.front().begin; }
+  const entry_t* end() const
+  { return iterations.empty() ? entries.data() : entries.data() + iterations.front().end; }
+};
+
 /* Contains any data collected during / at the end of combat
  * Mostly statistical data collection, represented as sample data containers
  */
@@ -3213,14 +3843,16 @@ struct player_collected_data_t
   // Metric used to end simulations early
   extended_sample_data_t target_metric;
   mutex_t target_metric_mutex;
+  double iteration_target_metric; // Target metric of the current iteration (this thread)
 
   std::array<simple_sample_data_t,RESOURCE_MAX> resource_lost, resource_gained;
   struct resource_timeline_t
   {
     resource_e type;
     sc_timeline_t timeline;
+    double sparse_value; // Last recorded value with sparse timeline collection
 
-    resource_timeline_t( resource_e t = RESOURCE_NONE ) : type( t ) {}
+    resource_timeline_t( resource_e t = RESOURCE_NONE ) : type( t ), sparse_value( 0 ) {}
   };
   // Druid requires 4 resource timelines health/mana/energy/rage
   std::vector<resource_timeline_t> resource_timelines;
@@ -3231,8 +3863,9 @@ struct player_collected_data_t
   {
     stat_e type;
     sc_timeline_t timeline;
+    double sparse_value; // Last recorded value with sparse timeline collection
 
-    stat_timeline_t( stat_e t = STAT_NONE ) : type( t ) {}
+    stat_timeline_t( stat_e t = STAT_NONE ) : type( t ), sparse_value( 0 ) {}
   };
 
   std::vector<stat_timeline_t> stat_timelines;
@@ -3269,21 +3902,7 @@ struct player_collected_data_t
   health_changes_timeline_t health_changes;     //records all health changes
   health_changes_timeline_t health_changes_tmi; //records only health changes due to damage and self-healng/self-absorb
 
-  struct action_sequence_data_t
-  {
-    const action_t* action;
-    const player_t* target;
-    const timespan_t time;
-    timespan_t wait_time;
-    std::vector<std::pair<buff_t*, int> > buff_list;
-    std::array<double, RESOURCE_MAX> resource_snapshot;
-    std::array<double, RESOURCE_MAX> resource_max_snapshot;
-
-    action_sequence_data_t( const timespan_t& ts, const timespan_t& wait, const player_t* p );
-    action_sequence_data_t( const action_t* a, const player_t* t, const timespan_t& ts, const player_t* p );
-  };
-  auto_dispose< std::vector<action_sequence_data_t*> > action_sequence;
-  auto_dispose< std::vector<action_sequence_data_t*> > action_sequence_precombat;
+  action_sequence_t action_sequence;
 
   // Buffed snapshot_stats (for reporting)
   struct buffed_stats_t
@@ -3305,6 +3924,10 @@ struct player_collected_data_t
   void merge( const player_collected_data_t& );
   void analyze( const player_t& );
   void collect_data( const player_t& );
+  // Minimal data set: fight length, damage and healing taken
+  void collect_minimal_data( const player_t& );
+  void merge_minimal( const player_collected_data_t& );
+  void analyze_minimal();
   void print_tmi_debug_csv( const sc_timeline_t* nma, const std::vector<double>& weighted_value, const player_t& p );
   double calculate_tmi( const health_changes_timeline_t& tl, int window, double f_length, const player_t& p );
   double calculate_max_spike_damage( const health_changes_timeline_t& tl, int window );
@@ -3480,9 +4103,11 @@ struct action_variable_t
 {
   std::string name_;
   double current_value_, default_;
+  // Variable can only ever hold its default value, set by player_t::optimize_action_lists
+  bool constant_;
 
   action_variable_t( const std::string& name, double def = 0 ) :
-    name_( name ), current_value_( def ), default_( def )
+    name_( name ), current_value_( def ), default_( def ), constant_( false )
   { }
 
   double value() const
@@ -3492,6 +4117,25 @@ struct action_variable_t
   { current_value_ = default_; }
 };
 
+// Results of the whole action list optimization, see player_t::optimize_action_lists
+struct apl_optimization_t
+{
+  unsigned entries;            // Action list entries before the optimization
+  unsigned false_conditions;   // Entries removed, their condition is statically false
+  unsigned empty_calls;        // call_action_list entries removed, the called list is empty
+  unsigned variable_entries;   // variable entries removed, the variable is constant
+  unsigned true_conditions;    // Statically true conditions replaced with a constant
+  unsigned constant_variables; // Variables turned into constants
+
+  apl_optimization_t() :
+    entries( 0 ), false_conditions( 0 ), empty_calls( 0 ), variable_entries( 0 ),
+    true_conditions( 0 ), constant_variables( 0 )
+  { }
+
+  unsigned removed() const
+  { return false_conditions + empty_calls + variable_entries; }
+};
+
 struct scaling_metric_data_t {
   std::string name;
   double value, stddev;
@@ -3755,6 +4399,7 @@ struct player_t : public actor_t
   std::string use_apl;
   bool use_default_action_list;
   auto_dispose< std::vector<dot_t*> > dot_list;
+  dot_tick_scheduler_t dot_ticks; // Pending ticks of DoTs with this actor as the source
   auto_dispose< std::vector<action_priority_list_t*> > action_priority_list;
   std::vector<action_t*> precombat_action_list;
   action_priority_list_t* active_action_list;
@@ -3765,6 +4410,9 @@ struct player_t : public actor_t
   bool no_action_list_provided;
 
   bool quiet;
+  // Only collect the minimal data set (see player_collected_data_t), and skip buff, stats and
+  // other per-actor report data. Used for raid event adds.
+  bool minimal_data_collection;
   // Reporting
   std::unique_ptr<player_report_extension_t> report_extension;
   timespan_t iteration_fight_length, arise_time;
@@ -3772,6 +4420,7 @@ struct player_t : public actor_t
   int iteration_executed_foreground_actions;
   std::array< double, RESOURCE_MAX > iteration_resource_lost, iteration_resource_gained;
   double rps_gain, rps_loss;
+  double init_time; // Wall clock seconds spent initializing the actor
   std::string tmi_debug_file_str;
   double tmi_window;
 
@@ -3784,10 +4433,26 @@ struct player_t : public actor_t
   auto_dispose< std::vector<cooldown_t*> > cooldown_list;
   auto_dispose< std::vector<real_ppm_t*> > rppm_list;
   std::vector<cooldown_t*> dynamic_cooldown_list;
+  // Dynamic cooldowns started since the last haste change that found them ready, in
+  // dynamic_cooldown_list order. Haste changes only need to rescale these.
+  std::vector<cooldown_t*> running_dynamic_cooldowns;
   std::array< std::vector<plot_data_t>, STAT_MAX > dps_plot_data;
   std::vector<std::vector<plot_data_t> > reforge_plot_data;
   auto_dispose< std::vector<luxurious_sample_data_t*> > sample_data_list;
 
+  // Hash indexes of the registries above by interned name, maintained by the get_*() functions and
+  // buff_t construction
+  symbol_table_t symbols;
+  symbol_index_t<buff_t> buff_index;
+  symbol_index_t<proc_t> proc_index;
+  symbol_index_t<gain_t> gain_index;
+  symbol_index_t<stats_t> stats_index;
+  symbol_index_t<benefit_t> benefit_index;
+  symbol_index_t<uptime_t> uptime_index;
+  symbol_index_t<cooldown_t> cooldown_index;
+  symbol_index_t<dot_t> dot_index;
+  symbol_index_t<luxurious_sample_data_t> sample_data_index;
+
   // All Data collected during / end of combat
   player_collected_data_t collected_data;
 
@@ -3987,6 +4652,12 @@ struct player_t : public actor_t
   } passive_values;
 
   bool active_during_iteration;
+
+  // Sparse timeline collection state (sim option sparse_timelines)
+  bool sparse_timeline_active;
+  event_t* sparse_timeline_event;
+  player_stat_cache_t::mask_t sparse_timeline_caches; // Cache entries behind the stat timelines
+
   const spelleffect_data_t* _mastery; // = find_mastery_spell( specialization() ) -> effectN( 1 );
 
   player_t( sim_t* sim, player_e type, const std::string& name, race_e race_e );
@@ -4041,6 +4712,7 @@ struct player_t : public actor_t
   virtual bool create_actions();
   virtual bool init_actions();
   virtual bool init_finished();
+  void optimize_action_lists( apl_optimization_t& );
 
   // Verify that the user input (APL) contains an use-item line for all on-use items
   virtual bool verify_use_items() const;
@@ -4197,6 +4869,11 @@ struct player_t : public actor_t
 
   // Stat Caching
   player_stat_cache_t cache;
+  // Transitive base invalidation mask per cache entry
+  std::array<player_stat_cache_t::mask_t, CACHE_MAX> cache_invalidation_mask;
+  // Indirectly invalidated cache entries passed on to invalidate_cache()
+  player_stat_cache_t::mask_t cache_invalidation_notify;
+  void init_cache_invalidation( bool exact = true );
 #if defined(SC_USE_STAT_CACHE)
   virtual void invalidate_cache( cache_e c );
 #else
@@ -4229,6 +4906,12 @@ struct player_t : public actor_t
   virtual void   recalculate_resource_max( resource_e resource_type );
   virtual bool   resource_available( resource_e resource_type, double cost ) const;
   void collect_resource_timeline_information();
+  double stat_timeline_value( stat_e stat ) const;
+  void sparse_timeline_begin();
+  void sparse_timeline_end();
+  void sparse_timeline_sync();
+  void sparse_timeline_schedule_sync();
+  void sparse_timeline_resource( resource_e resource_type );
   virtual resource_e primary_resource() const { return RESOURCE_NONE; }
   virtual role_e   primary_role() const;
   virtual stat_e convert_hybrid_stat( stat_e s ) const { return s; }
@@ -4353,6 +5036,7 @@ struct player_t : public actor_t
   pet_t*    find_pet( const std::string& name ) const;
   item_t*     find_item( const std::string& );
   action_t*   find_action( const std::string& ) const;
+  buff_t*     find_buff    ( const std::string& name, player_t* source = nullptr ) const;
   cooldown_t* find_cooldown( const std::string& name ) const;
   dot_t*      find_dot     ( const std::string& name, player_t* source ) const;
   stats_t*    find_stats   ( const std::string& name ) const;
@@ -4372,9 +5056,11 @@ struct player_t : public actor_t
   benefit_t*  get_benefit ( const std::string& name );
   uptime_t*   get_uptime  ( const std::string& name );
   luxurious_sample_data_t* get_sample_data( const std::string& name );
+  void        register_buff( buff_t* buff );
   double      get_player_distance( const player_t& ) const;
   double      get_ground_aoe_distance( action_state_t& ) const;
   double      get_position_distance( double m = 0, double v = 0 ) const;
+  bool        set_position( double x, double y );
   double avg_item_level() const;
   action_priority_list_t* get_action_priority_list( const std::string& name, const std::string& comment = std::string() );
 
@@ -4539,8 +5225,8 @@ public:
   }
 
   virtual void adjust_action_queue_time();
-  virtual void adjust_dynamic_cooldowns()
-  { range::for_each( dynamic_cooldown_list, []( cooldown_t* cd ) { cd -> adjust_recharge_multiplier(); } ); }
+  virtual void adjust_dynamic_cooldowns();
+  void add_running_dynamic_cooldown( cooldown_t* cd );
   virtual void adjust_global_cooldown( haste_type_e haste_type );
   virtual void adjust_auto_attack( haste_type_e haste_type );
 
@@ -4634,6 +5320,11 @@ public:
 
 // Target Specific ==========================================================
 
+/* Per-target object table, indexed by the actor index of the target. Objects constructed through
+ * create() are placed in dense slots, allocated in blocks of consecutive actor indices, so the
+ * objects of (source, target) pairs need no individual heap allocations, and neighbouring targets
+ * (eg. enemies and their adds) end up next to each other in memory.
+ */
 template < class T >
 struct target_specific_t
 {
@@ -4645,19 +5336,62 @@ public:
   T*& operator[](  const player_t* target ) const
   {
     assert( target );
-    if ( data.empty() )
+    if ( target -> actor_index >= data.size() )
     {
-      data.resize( target -> sim -> actor_list.size() );
+      data.resize( std::max( target -> sim -> actor_list.size(), target -> actor_index + size_t( 1 ) ) );
     }
     return data[ target -> actor_index ];
   }
+
+  // Construct the object for target into its pooled slot
+  template <typename... Args>
+  T* create( const player_t* target, Args&&... args ) const
+  {
+    T*& obj = ( *this )[ target ];
+    assert( ! obj );
+
+    size_t block = target -> actor_index / block_size;
+    if ( block >= pool.size() )
+    {
+      pool.resize( block + 1, nullptr );
+    }
+
+    if ( ! pool[ block ] )
+    {
+      pool[ block ] = static_cast<T*>( ::operator new( sizeof( T ) * block_size ) );
+    }
+
+    obj = new ( pool[ block ] + target -> actor_index % block_size ) T( std::forward<Args>( args )... );
+    return obj;
+  }
+
   ~target_specific_t()
   {
-    if ( owner_ )
-      range::dispose( data );
+    for ( size_t i = 0; i < data.size(); ++i )
+    {
+      if ( ! data[ i ] )
+        continue;
+
+      if ( pooled( i ) )
+        data[ i ] -> ~T();
+      else if ( owner_ )
+        delete data[ i ];
+    }
+
+    for ( auto block : pool )
+      ::operator delete( block );
   }
 private:
+  static const size_t block_size = 8;
+
+  bool pooled( size_t index ) const
+  {
+    size_t block = index / block_size;
+    return block < pool.size() && pool[ block ] && data[ index ] == pool[ block ] + index % block_size;
+  }
+
   mutable std::vector<T*> data;
+  mutable std::vector<T*> pool;
 };
 
 struct player_event_t : public event_t
@@ -4715,6 +5449,11 @@ struct pet_t : public player_t
   timespan_t duration;
   bool affects_wod_legendary_ring;
 
+  // Pet pool membership, see pet_pool_t
+  pet_pool_base_t* pool;
+  bool pool_spawned; // Spawned at least once during the simulation
+  bool pool_dirty;   // Spawned since the last reset
+
   struct owner_coefficients_t
   {
     double armor, health, ap_from_ap, ap_from_sp, sp_from_ap, sp_from_sp;
@@ -4731,6 +5470,8 @@ public:
   virtual void init_base_stats() override;
   virtual void init_target() override;
   virtual void reset() override;
+  virtual void arise() override;
+  virtual void merge( player_t& other ) override;
   virtual void summon( timespan_t duration = timespan_t::zero() );
   virtual void dismiss( bool expired = false );
   virtual void assess_damage( school_e, dmg_e, action_state_t* s ) override;
@@ -4808,7 +5549,70 @@ public:
 
   virtual void init_resources( bool force ) override;
   virtual bool requires_data_collection() const override
-  { return active_during_iteration || ( dynamic && sim -> report_pets_separately == 1 ); }
+  { return active_during_iteration || ( dynamic && sim -> report_pets_separately == 1 && ! idle_pool_member() ); }
+
+  // Pool member that has never been spawned, and thus has no state or data to process
+  bool idle_pool_member() const
+  { return pool && ! pool_spawned; }
+};
+
+// Pet Pool =================================================================
+
+/* Pool of interchangeable, dynamically summoned pets. Spawning uses the lowest idle member, so the
+ * members that are ever used follow the peak concurrency observed during the simulation. Members
+ * that have not been spawned are not reset between iterations, and are skipped in data
+ * collection, merging and analysis. Members are created during init at a fixed size; spawning
+ * fails (returns nullptr) when all members are active.
+ */
+struct pet_pool_base_t
+{
+  void add_member( pet_t* pet )
+  { pet -> pool = this; }
+};
+
+template <typename T>
+struct pet_pool_t : public pet_pool_base_t
+{
+  typedef typename std::vector<T*>::const_iterator const_iterator;
+
+  std::vector<T*> members;
+
+  void add( T* pet )
+  {
+    add_member( pet );
+    members.push_back( pet );
+  }
+
+  // Lowest idle member, or nullptr if all members are spawned
+  T* idle() const
+  {
+    for ( auto pet : members )
+    {
+      if ( pet -> is_sleeping() )
+        return pet;
+    }
+    return nullptr;
+  }
+
+  // Spawn the lowest idle member for the given duration, returns nullptr if the pool is exhausted
+  T* spawn( timespan_t duration = timespan_t::zero() )
+  {
+    T* pet = idle();
+    if ( pet )
+      pet -> summon( duration );
+    return pet;
+  }
+
+  T* operator[]( size_t idx ) const
+  { return members[ idx ]; }
+  size_t size() const
+  { return members.size(); }
+  bool empty() const
+  { return members.empty(); }
+  const_iterator begin() const
+  { return members.begin(); }
+  const_iterator end() const
+  { return members.end(); }
 };
 
 
@@ -4869,6 +5673,7 @@ public:
   simple_sample_data_t total_execute_time, total_tick_time;
   timespan_t iteration_total_execute_time, iteration_total_tick_time;
   double portion_amount;
+  double iteration_actual_amount; // Actual amount of the last finished iteration
   simple_sample_data_t total_intervals;
   timespan_t last_execute;
   extended_sample_data_t actual_amount, total_amount, portion_aps, portion_apse;
@@ -5069,15 +5874,28 @@ public:
   /**
    * Target Cache System
    * - list: contains the cached target pointers
-   * - callback: unique_Ptr to callback
-   * - is_valid: gets invalidated by the callback from the target list source.
+   * - source: sim target list the cache is built from ( see init_target_cache() )
+   * - version: version of the source list when the cache was last checked
+   * - is_valid: gets invalidated when the source list changes, or manually.
    *  When the target list is requested in action_t::target_list(), it gets recalculated if
-   *  flag is false, otherwise cached version is used
+   *  check_valid() returns false, otherwise cached version is used
    */
   struct target_cache_t {
     std::vector< player_t* > list;
+    const vector_with_callback<player_t*>* source;
+    unsigned version;
     bool is_valid;
-    target_cache_t() : is_valid( false ) {}
+    target_cache_t() : source( nullptr ), version( 0 ), is_valid( false ) {}
+
+    bool check_valid()
+    {
+      if ( source && source -> version() != version )
+      {
+        version = source -> version();
+        is_valid = false;
+      }
+      return is_valid;
+    }
   } mutable target_cache;
 
   enum target_if_mode_e
@@ -5589,9 +6407,9 @@ public:
 
   virtual bool impact_targeting( action_state_t* s ) const;
 
-  virtual std::vector<player_t*> targets_in_range_list( std::vector< player_t* >& tl ) const;
+  virtual std::vector<player_t*>& targets_in_range_list( std::vector< player_t* >& tl ) const;
 
-  virtual std::vector<player_t*> check_distance_targeting( std::vector< player_t* >& tl ) const;
+  virtual std::vector<player_t*>& check_distance_targeting( std::vector< player_t* >& tl ) const;
 
   virtual double ppm_proc_chance( double PPM ) const;
 
@@ -6294,16 +7112,17 @@ inline proc_types2 action_state_t::cast_proc_type2() const
 
 // DoT Tick Event ===========================================================
 
+// Timing wheel event for the earliest pending DoT tick of an actor, see dot_tick_scheduler_t
 struct dot_tick_event_t : public event_t
 {
 public:
-  dot_tick_event_t( dot_t* d, timespan_t time_to_tick );
+  dot_tick_event_t( player_t* p, dot_tick_scheduler_t& s, const dot_tick_t& tick );
 
 private:
   virtual void execute() override;
   virtual const char* name() const override
   { return "Dot Tick"; }
-  dot_t* dot;
+  dot_tick_scheduler_t& scheduler;
 };
 
 // DoT End Event ===========================================================
@@ -6330,8 +7149,9 @@ private:
   timespan_t extended_time; // Added time per extend_duration for the current dot application
   timespan_t reduced_time; // Removed time per reduce_duration for the current dot application
   int stack;
+  dot_tick_t tick_entry;
 public:
-  event_t* tick_event;
+  dot_tick_t* tick_event; // Points to tick_entry while a tick is scheduled
   event_t* end_event;
   double last_tick_factor;
 
@@ -6388,66 +7208,36 @@ public:
 private:
   void tick_zero();
   void schedule_tick();
+  void schedule_tick_event( timespan_t time_to_tick );
+  void cancel_tick_event();
   void start( timespan_t duration );
   void refresh( timespan_t duration );
   void check_tick_zero();
   bool is_higher_priority_action_available() const;
 
-  friend struct dot_tick_event_t;
+  friend struct dot_tick_scheduler_t;
   friend struct dot_end_event_t;
 };
 
 inline double action_t::last_tick_factor( const dot_t* /* d */, const timespan_t& time_to_tick, const timespan_t& duration ) const
 { return std::min( 1.0, duration / time_to_tick ); }
 
-inline dot_tick_event_t::dot_tick_event_t( dot_t* d, timespan_t time_to_tick ) :
-    event_t( *d -> source, time_to_tick ),
-  dot( d )
+inline timespan_t dot_tick_t::remains() const
+{ return occurs() - dot -> source -> sim -> current_time(); }
+
+inline dot_tick_event_t::dot_tick_event_t( player_t* p, dot_tick_scheduler_t& s, const dot_tick_t& tick ) :
+  event_t( *p ),
+  scheduler( s )
 {
-  if ( sim().debug )
-    sim().out_debug.printf( "New DoT Tick Event: %s %s %d-of-%d %.4f",
-                d -> source -> name(), dot -> name(), dot -> current_tick + 1, dot -> num_ticks, time_to_tick.total_seconds() );
+  // Take the place of the tick in the timing wheel, instead of scheduling as a new event
+  time = tick.time;
+  id = tick.id;
+  scheduled = true;
+  sim().event_mgr.insert_event( this );
 }
 
-
 inline void dot_tick_event_t::execute()
-{
-  dot -> tick_event = nullptr;
-  dot -> current_tick++;
-
-  if ( dot -> current_action -> channeled &&
-       dot -> current_action -> action_skill < 1.0 &&
-       dot -> remains() >= dot -> current_action -> tick_time( dot -> state ) )
-  {
-    if ( rng().roll( std::max( 0.0, dot -> current_action -> action_skill - dot -> current_action -> player -> current.skill_debuff ) ) )
-    {
-      dot -> tick();
-    }
-  }
-  else // No skill-check required
-  {
-    dot -> tick();
-  }
-
-  // Some dots actually cancel themselves mid-tick. If this happens, we presume
-  // that the cancel has been "proper", and just stop event execution here, as
-  // the dot no longer exists.
-  if ( ! dot -> is_ticking() )
-    return;
-
-  if ( ! dot -> current_action -> consume_cost_per_tick( *dot ) )
-  {
-    return;
-  }
-
-  if ( dot -> channel_interrupt() )
-  {
-    return;
-  }
-
-  // continue ticking
-  dot->schedule_tick();
-}
+{ scheduler.execute(); }
 
 inline dot_end_event_t::dot_end_event_t( dot_t* d, timespan_t time_to_end ) :
     event_t( *d -> source, time_to_end ),
@@ -6505,6 +7295,12 @@ struct action_callback_t : private noncopyable
   virtual void activate() { active = true; }
   virtual void deactivate() { active = false; }
 
+  // Gating state for the prefiltered proc dispatch in effect_callbacks_t, read once on
+  // registration. trigger() is never called while the returned cooldown is down, or for actions
+  // that do not use the returned weapon.
+  virtual const cooldown_t* dispatch_cooldown() const { return nullptr; }
+  virtual const weapon_t* dispatch_weapon() const { return nullptr; }
+
   static void trigger( const std::vector<action_callback_t*>& v, action_t* a, void* call_data = nullptr )
   {
     if ( a && ! a -> player -> in_combat ) return;
@@ -6585,6 +7381,12 @@ struct dbc_proc_callback_t : public action_callback_t
 
   virtual void initialize() override;
 
+  const cooldown_t* dispatch_cooldown() const override
+  { return cooldown; }
+
+  const weapon_t* dispatch_weapon() const override
+  { return weapon; }
+
   void trigger( action_t* a, void* call_data ) override
   {
     if ( cooldown && cooldown -> down() ) return;
@@ -7585,7 +8387,7 @@ inline buff_t* buff_t::find( sim_t* s, const std::string& name )
 }
 inline buff_t* buff_t::find( player_t* p, const std::string& name, player_t* source )
 {
-  return find( p -> buff_list, name, source );
+  return p -> find_buff( name, source );
 }
 inline std::string buff_t::source_name() const
 {
@@ -8028,11 +8830,16 @@ public:
 
 // effect_callbacks_t::register_callback =====================================
 
-template <typename T>
-static void add_callback( std::vector<T*>& callbacks, T* cb )
+template <typename T_CB>
+void effect_callbacks_t<T_CB>::add_callback( proc_types type, proc_types2 type2, T_CB* cb )
 {
-  if ( range::find( callbacks, cb ) == callbacks.end() )
-    callbacks.push_back( cb );
+  proc_list_t& callbacks = procs[ type ][ type2 ];
+  if ( range::find( callbacks, cb ) != callbacks.end() )
+    return;
+
+  callbacks.push_back( cb );
+  dispatch[ type ][ type2 ].push_back( dispatch_entry_t( cb ) );
+  dispatch_mask[ type ] |= 1U << type2;
 }
 
 template <typename T_CB>
@@ -8058,18 +8865,18 @@ void effect_callbacks_t<T_CB>::add_proc_callback( proc_types type,
            type == PROC1_PERIODIC_HEAL || type == PROC1_PERIODIC_HEAL_TAKEN ||
            type == PROC1_HEAL || type == PROC1_AOE_HEAL ) )
     {
-      add_callback( procs[ type ][ PROC2_HIT  ], cb );
+      add_callback( type, PROC2_HIT, cb );
       if ( cb -> listener -> sim -> debug )
         s << util::proc_type_string( type ) << util::proc_type2_string( PROC2_HIT ) << " ";
 
-      add_callback( procs[ type ][ PROC2_CRIT ], cb );
+      add_callback( type, PROC2_CRIT, cb );
       if ( cb -> listener -> sim -> debug )
         s << util::proc_type_string( type ) << util::proc_type2_string( PROC2_CRIT ) << " ";
     }
     // Do normal registration based on the existence of the flag
     else
     {
-      add_callback( procs[ type ][ pt ], cb );
+      add_callback( type, pt, cb );
       if ( cb -> listener -> sim -> debug )
         s << util::proc_type_string( type ) << util::proc_type2_string( pt ) << " ";
     }
@@ -8172,6 +8979,36 @@ void effect_callbacks_t<T_CB>::reset()
   T_CB::reset( all_callbacks );
 }
 
+// effect_callbacks_t::trigger ==============================================
+
+template <typename T_CB>
+void effect_callbacks_t<T_CB>::trigger( proc_types type, proc_types2 type2,
+                                        action_t* a, action_state_t* state ) const
+{
+  if ( ! has_callbacks( type, type2 ) ) return;
+
+  if ( a && ! a -> player -> in_combat ) return;
+
+  const dispatch_list_t& v = dispatch[ type ][ type2 ];
+  for ( size_t i = 0, end = v.size(); i < end; i++ )
+  {
+    const dispatch_entry_t& entry = v[ i ];
+    T_CB* cb = entry.cb;
+    if ( ! cb -> active )
+      continue;
+
+    if ( ! cb -> allow_procs && a && a -> proc ) return;
+
+    if ( entry.cooldown && entry.cooldown -> down() )
+      continue;
+
+    if ( entry.weapon && ( ! a -> weapon || a -> weapon != entry.weapon ) )
+      continue;
+
+    cb -> trigger( a, state );
+  }
+}
+
 /**
  * Targetdata initializer for items. When targetdata is constructed (due to a call to
  * player_t::get_target_data failing to find an object for the given target), all targetdata
@@ -125,6 +125,11 @@ unsigned sc_thread_t::cpu_thread_count()
 
 #if defined(SC_WINDOWS)
 #include <windows.h>
+// Version 2 maps GetProcessMemoryInfo to kernel32, no psapi.lib needed
+#ifndef PSAPI_VERSION
+#define PSAPI_VERSION 2
+#endif
+#include <psapi.h>
 
 DWORD translate_priority( computer_process::priority_e p )
 {
@@ -151,9 +156,104 @@ void computer_process::set_priority( priority_e p )
  }
 }
 
+size_t computer_process::peak_memory_usage()
+{
+  PROCESS_MEMORY_COUNTERS counters;
+  if ( ! GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+  {
+    return 0;
+  }
+
+  return counters.PeakWorkingSetSize;
+}
+
+// Processors of processor group 0 only, which covers machines with up to 64
+// logical processors
+std::vector<computer_process::cpu_t> computer_process::cpu_topology()
+{
+  std::vector<cpu_t> cpus;
+
+  DWORD length = 0;
+  GetLogicalProcessorInformation( nullptr, &length );
+  if ( GetLastError() != ERROR_INSUFFICIENT_BUFFER )
+  {
+    return cpus;
+  }
+
+  std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info( length / sizeof( SYSTEM_LOGICAL_PROCESSOR_INFORMATION ) );
+  DWORD_PTR process_mask, system_mask;
+  if ( ! GetLogicalProcessorInformation( info.data(), &length ) ||
+       ! GetProcessAffinityMask( GetCurrentProcess(), &process_mask, &system_mask ) )
+  {
+    return cpus;
+  }
+
+  for ( unsigned id = 0; id < sizeof( DWORD_PTR ) * 8; ++id )
+  {
+    DWORD_PTR bit = static_cast<DWORD_PTR>( 1 ) << id;
+    if ( ! ( process_mask & bit ) )
+      continue;
+
+    cpu_t cpu = { id, 0, 0, 0 };
+    unsigned core = 0, socket = 0;
+    for ( const auto& entry : info )
+    {
+      switch ( entry.Relationship )
+      {
+      case RelationProcessorCore:
+        if ( entry.ProcessorMask & bit )
+          cpu.core = core;
+        ++core;
+        break;
+      case RelationProcessorPackage:
+        if ( entry.ProcessorMask & bit )
+          cpu.socket = socket;
+        ++socket;
+        break;
+      case RelationNumaNode:
+        if ( entry.ProcessorMask & bit )
+          cpu.node = entry.NumaNode.NodeNumber;
+        break;
+      default:
+        break;
+      }
+    }
+    cpus.push_back( cpu );
+  }
+
+  return cpus;
+}
+
+bool computer_process::set_thread_affinity( const std::vector<unsigned>& cpus )
+{
+  DWORD_PTR mask = 0;
+  for ( auto id : cpus )
+  {
+    if ( id < sizeof( DWORD_PTR ) * 8 )
+      mask |= static_cast<DWORD_PTR>( 1 ) << id;
+  }
+
+  return mask != 0 && SetThreadAffinityMask( GetCurrentThread(), mask ) != 0;
+}
+
+int computer_process::current_cpu()
+{
+  return static_cast<int>( GetCurrentProcessorNumber() );
+}
+
 #elif defined(SC_OSX) || defined(__unix__)
 #include <sys/time.h>
 #include <sys/resource.h>
+#if defined(__linux__)
+#include <sched.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#endif
 
 int translate_priority( computer_process::priority_e p )
 {
@@ -179,9 +279,136 @@ void computer_process::set_priority( priority_e p )
     perror("Could not set process priority.");
   }
 }
+
+size_t computer_process::peak_memory_usage()
+{
+  struct rusage usage;
+  if ( getrusage( RUSAGE_SELF, &usage ) != 0 )
+  {
+    return 0;
+  }
+
+#if defined(SC_OSX)
+  return static_cast<size_t>( usage.ru_maxrss ); // bytes
+#else
+  return static_cast<size_t>( usage.ru_maxrss ) * 1024; // kilobytes
+#endif
+}
+
+#if defined(__linux__)
+unsigned read_topology_id( unsigned cpu, const char* name )
+{
+  std::ifstream in( "/sys/devices/system/cpu/cpu" + std::to_string( cpu ) + "/topology/" + name );
+  unsigned id = 0;
+  in >> id;
+  return id;
+}
+
+// NUMA node of a logical processor, from the nodeN link in its sysfs directory.
+// Kernels without NUMA support have no link, everything is node 0.
+unsigned read_node_id( unsigned cpu )
+{
+  std::string path = "/sys/devices/system/cpu/cpu" + std::to_string( cpu );
+  DIR* dir = opendir( path.c_str() );
+  if ( ! dir )
+  {
+    return 0;
+  }
+
+  unsigned node = 0;
+  while ( dirent* entry = readdir( dir ) )
+  {
+    if ( std::strncmp( entry -> d_name, "node", 4 ) == 0 && std::isdigit( entry -> d_name[ 4 ] ) )
+    {
+      node = static_cast<unsigned>( std::strtoul( entry -> d_name + 4, nullptr, 10 ) );
+      break;
+    }
+  }
+  closedir( dir );
+
+  return node;
+}
+
+std::vector<computer_process::cpu_t> computer_process::cpu_topology()
+{
+  std::vector<cpu_t> cpus;
+
+  cpu_set_t set;
+  CPU_ZERO( &set );
+  if ( sched_getaffinity( 0, sizeof( set ), &set ) != 0 )
+  {
+    return cpus;
+  }
+
+  for ( unsigned id = 0; id < CPU_SETSIZE; ++id )
+  {
+    if ( ! CPU_ISSET( id, &set ) )
+      continue;
+
+    cpu_t cpu = { id, read_topology_id( id, "core_id" ), read_topology_id( id, "physical_package_id" ), read_node_id( id ) };
+    cpus.push_back( cpu );
+  }
+
+  return cpus;
+}
+
+bool computer_process::set_thread_affinity( const std::vector<unsigned>& cpus )
+{
+  cpu_set_t set;
+  CPU_ZERO( &set );
+  for ( auto id : cpus )
+  {
+    if ( id < CPU_SETSIZE )
+      CPU_SET( id, &set );
+  }
+
+  return CPU_COUNT( &set ) > 0 && pthread_setaffinity_np( pthread_self(), sizeof( set ), &set ) == 0;
+}
+
+int computer_process::current_cpu()
+{
+  return sched_getcpu();
+}
+#else
+std::vector<computer_process::cpu_t> computer_process::cpu_topology()
+{
+  return std::vector<cpu_t>();
+}
+
+// OS X has no interface to bind threads to processors
+bool computer_process::set_thread_affinity( const std::vector<unsigned>& )
+{
+  return false;
+}
+
+int computer_process::current_cpu()
+{
+  return -1;
+}
+#endif
 #else
 void computer_process::set_priority( priority_e )
 {
   // do nothing
 }
+
+size_t computer_process::peak_memory_usage()
+{
+  return 0;
+}
+
+std::vector<computer_process::cpu_t> computer_process::cpu_topology()
+{
+  return std::vector<cpu_t>();
+}
+
+bool computer_process::set_thread_affinity( const std::vector<unsigned>& )
+{
+  return false;
+}
+
+int computer_process::current_cpu()
+{
+  return -1;
+}
 #endif
@@ -14,6 +14,7 @@
 #include "config.hpp"
 #include "generic.hpp"
 #include <memory>
+#include <vector>
 
 
 class mutex_t : private noncopyable
@@ -67,5 +68,20 @@ enum priority_e {
   LOW
 };
 void set_priority( priority_e);
+// Peak resident memory of the process in bytes, 0 if not available
+size_t peak_memory_usage();
+
+// Logical processor, with its physical core, socket and NUMA node
+struct cpu_t
+{
+  unsigned id, core, socket, node;
+};
+
+// Logical processors the process may run on, empty if not available
+std::vector<cpu_t> cpu_topology();
+// Restrict the calling thread to the logical processors, false if not supported
+bool set_thread_affinity( const std::vector<unsigned>& cpus );
+// Logical processor the calling thread runs on, -1 if not available
+int current_cpu();
 
 } // computer_process
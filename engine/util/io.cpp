@@ -154,7 +154,7 @@ ofstream& ofstream::format( const char* fmt, ... )
   std::string buffer = str::format( fmt, fmtargs );
   va_end( fmtargs );
 
-  *this << buffer;
+  write( buffer.data(), buffer.size() );
 
   return *this;
 }
@@ -778,6 +778,25 @@ rng_t::type_e parse_type( const std::string& n )
   return rng_t::DEFAULT;
 }
 
+/**
+ * @brief Seed of an independent random stream derived from a base seed
+ *
+ * Mixes the stream number into the seed with the MURMURHASH3 finalizer, so
+ * neighbouring streams (e.g. consecutive iterations) get unrelated seeds.
+ * Never returns 0, which some engines cannot be seeded with.
+ */
+uint64_t stream_seed( uint64_t seed, uint64_t stream )
+{
+  uint64_t x = seed + ( stream + 1 ) * 0x9e3779b97f4a7c15ULL;
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+
+  return x ? x : 1;
+}
+
 /**
  * Factory method to create a rng object with given rng-engine type
  */
@@ -995,6 +1014,8 @@ double stdnormal_inv( double p )
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <vector>
 
 namespace rng {
 static int64_t milliseconds()
@@ -1061,11 +1082,73 @@ static void monte_carlo( rng_t* rng, uint64_t n )
                ", numbers/sec = " << static_cast<uint64_t>( n * 1000.0 / elapsed_cpu ) << "\n\n";
 }
 
+// Seeds of per-iteration streams (deterministic_iterations=1) must never change,
+// and neighbouring streams must get unrelated seeds.
+static bool test_stream_seed()
+{
+  struct { uint64_t seed, stream, expected; } fixed[] = {
+    { 0,         0,                   0x9ca066f1a4ab2eeaULL },
+    { 31459,     0,                   0x7d8dd696b854a871ULL },
+    { 31459,     1,                   0x793beb239d35bd79ULL },
+    { 31459,     1000,                0x708b1ee5bc7df2b5ULL },
+    { 123456789, uint64_t( 1 ) << 40, 0xf06b5fba49c3b0e0ULL },
+  };
+
+  bool ok = true;
+  for ( const auto& f : fixed )
+  {
+    uint64_t s = stream_seed( f.seed, f.stream );
+    if ( s != f.expected )
+    {
+      std::cout << "stream_seed( " << f.seed << ", " << f.stream << " ) = " << std::hex << s
+                << ", expected " << f.expected << std::dec << "\n";
+      ok = false;
+    }
+  }
+
+  // Consecutive streams have distinct seeds that differ in about half of their bits,
+  // and give distinct first numbers from the same engine
+  const uint64_t n = 10000;
+  std::vector<uint64_t> seeds;
+  uint64_t bits = 0;
+  unsigned same_first = 0;
+  rng_xorshift1024_t a, b;
+  for ( uint64_t i = 0; i < n; ++i )
+  {
+    uint64_t x = stream_seed( 31459, i ), y = stream_seed( 31459, i + 1 );
+    seeds.push_back( x );
+    for ( uint64_t d = x ^ y; d; d &= d - 1 )
+      ++bits;
+
+    a.seed( x );
+    b.seed( y );
+    if ( a.real() == b.real() )
+      ++same_first;
+  }
+  std::sort( seeds.begin(), seeds.end() );
+  bool distinct = std::adjacent_find( seeds.begin(), seeds.end() ) == seeds.end();
+  double mean_bits = static_cast<double>( bits ) / n;
+  if ( ! distinct || mean_bits < 30 || mean_bits > 34 || same_first > 0 )
+  {
+    std::cout << "stream_seed neighbouring streams: distinct=" << distinct
+              << ", mean differing bits=" << mean_bits << ", identical first numbers=" << same_first << "\n";
+    ok = false;
+  }
+
+  std::cout << "stream_seed: " << ( ok ? "PASSED" : "FAILED" ) << "\n\n";
+
+  return ok;
+}
+
 } // namespace rng
 
 int main( int /*argc*/, char** /*argv*/ )
 {
   using namespace rng;
+
+  if ( ! test_stream_seed() )
+    return 1;
+
   rng_t* rng_mt_cxx11   = new rng_mt_cxx11_t();
   rng_t* rng_mt_cxx11_64   = new rng_mt_cxx11_64_t();
   rng_t* rng_murmurhash   = new rng_murmurhash_t();
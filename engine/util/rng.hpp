@@ -56,6 +56,7 @@ private:
 
 std::unique_ptr<rng_t> create( rng_t::type_e = rng_t::DEFAULT );
 rng_t::type_e parse_type( const std::string& name );
+uint64_t stream_seed( uint64_t seed, uint64_t stream );
 
 double stdnormal_cdf( double );
 double stdnormal_inv( double );
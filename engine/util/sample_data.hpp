@@ -229,6 +229,12 @@ public:
     ++_count;
   }
 
+  // Add n samples of value zero, the sum is unaffected
+  void add_zeros( size_t n )
+  {
+    _count += n;
+  }
+
   value_t mean() const
   {
     return _count ? _sum / _count : nan();
@@ -255,6 +261,13 @@ public:
     _sum += other._sum;
   }
 
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    ar( _sum );
+    ar( _count );
+  }
+
   void reset()
   {
     _count = 0u;
@@ -329,6 +342,15 @@ public:
       }
     }
   }
+
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    base_t::serialize( ar );
+    ar.any( _found );
+    ar.min( _min );
+    ar.max( _max );
+  }
 };
 
 /* Extensive sample_data container with two runtime dependent modes:
@@ -447,7 +469,9 @@ public:
       base_t::set_max( *minmax.second );
     }
 
-    base_t::_sum = statistics::calculate_sum( data() );
+    // Summing the sorted data makes the result independent of the order in which
+    // threads were merged
+    base_t::_sum = statistics::calculate_sum( sorted() ? sorted_data() : data() );
     _mean        = base_t::_sum / data().size();
   }
 
@@ -475,7 +499,7 @@ public:
     if ( _data.empty() )
       return;
 
-    variance = statistics::calculate_variance( data(), mean() );
+    variance = statistics::calculate_variance( sorted() ? sorted_data() : data(), mean() );
     std_dev  = std::sqrt( variance );
 
     // Calculate Standard Deviation of the Mean ( Central Limit Theorem )
@@ -569,6 +593,19 @@ public:
       _data.insert( _data.end(), other._data.begin(), other._data.end() );
   }
 
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    ar.match( simple );
+
+    if ( simple )
+    {
+      base_t::serialize( ar );
+    }
+    else
+      ar.append( _data );
+  }
+
   std::ostream& data_str( std::ostream& s ) const
   {
     s << "Sample_Data \"" << name_str << "\": count: " << count();
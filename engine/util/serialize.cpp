@@ -0,0 +1,273 @@
+#ifdef UNIT_TEST
+// Round trip tests of the serialize::writer_t / reader_t archives
+
+#include "serialize.hpp"
+#include "unit_test.hpp"
+#include <iostream>
+#include <memory>
+
+namespace
+{
+using unit_test::check;
+
+template <typename Fn>
+bool throws( Fn fn )
+{
+  try
+  {
+    fn();
+  }
+  catch ( const std::runtime_error& )
+  {
+    return true;
+  }
+  return false;
+}
+
+struct entry_t
+{
+  std::string name;
+  double value;
+
+  entry_t( const std::string& n, double v ) : name( n ), value( v )
+  { }
+};
+
+struct state_t
+{
+  int count;
+  double sum;
+  double min, max;
+  bool seen;
+  std::array<unsigned, 3> buckets;
+  std::vector<double> per_bucket;
+  std::vector<int> samples;
+  std::vector<std::unique_ptr<entry_t>> entries;
+
+  state_t() : count( 0 ), sum( 0 ), min( 0 ), max( 0 ), seen( false ), buckets()
+  { }
+
+  entry_t* find( const std::string& name ) const
+  {
+    for ( auto& e : entries )
+    {
+      if ( e -> name == name )
+        return e.get();
+    }
+    return nullptr;
+  }
+
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    ar( count );
+    ar( sum );
+    ar.min( min );
+    ar.max( max );
+    ar.any( seen );
+    ar( buckets );
+    ar( per_bucket );
+    ar.append( samples );
+    ar.named( entries,
+              []( const entry_t& e ) { return e.name; },
+              [ this ]( const std::string& name ) { return find( name ); },
+              []( Archive& a, entry_t& e ) { a( e.value ); } );
+  }
+};
+
+// Named collection of states, entries are nested one level deeper
+struct group_t
+{
+  std::string name;
+  state_t state;
+
+  group_t( const std::string& n ) : name( n )
+  { }
+};
+
+template <typename Archive>
+void serialize_groups( Archive& ar, std::vector<std::unique_ptr<group_t>>& groups )
+{
+  ar.named( groups,
+            []( const group_t& g ) { return g.name; },
+            [ &groups ]( const std::string& name ) -> group_t* {
+              for ( auto& g : groups )
+              {
+                if ( g -> name == name )
+                  return g.get();
+              }
+              return nullptr;
+            },
+            []( Archive& a, group_t& g ) { g.state.serialize( a ); } );
+}
+
+std::string write_version( uint32_t version )
+{
+  serialize::writer_t w;
+  w.write( version );
+  w.write_string( "payload" );
+  return w.data();
+}
+
+void test_values()
+{
+  serialize::writer_t w;
+  w.write( int8_t( -5 ) );
+  w.write( uint16_t( 65000 ) );
+  w.write( int32_t( -123456 ) );
+  w.write( uint64_t( 1 ) << 40 );
+  w.write( 0.1f );
+  w.write( 3.25 );
+  w.write( true );
+  w.write_string( std::string() );
+  w.write_string( std::string( "a\0b", 3 ) );
+
+  serialize::reader_t r( w.data() );
+  check( r.read<int8_t>() == -5, "int8_t round trip" );
+  check( r.read<uint16_t>() == 65000, "uint16_t round trip" );
+  check( r.read<int32_t>() == -123456, "int32_t round trip" );
+  check( r.read<uint64_t>() == uint64_t( 1 ) << 40, "uint64_t round trip" );
+  check( r.read<float>() == 0.1f, "float round trip" );
+  check( r.read<double>() == 3.25, "double round trip" );
+  check( r.read<bool>() == true, "bool round trip" );
+  check( r.read_string().empty(), "empty string round trip" );
+  check( r.read_string() == std::string( "a\0b", 3 ), "string with embedded zero round trip" );
+  check( r.empty(), "all data consumed" );
+}
+
+void test_merge()
+{
+  state_t a;
+  a.count = 3;
+  a.sum = 1.5;
+  a.min = 2;
+  a.max = 10;
+  a.seen = false;
+  a.buckets = { { 1, 2, 3 } };
+  a.per_bucket = { 1.0, 2.0, 3.0 };
+  a.samples = { 7, 8 };
+  a.entries.emplace_back( new entry_t( "shared", 1.0 ) );
+  a.entries.emplace_back( new entry_t( "only_a", 5.0 ) );
+
+  state_t b;
+  b.count = 2;
+  b.sum = 0.5;
+  b.min = 1;
+  b.max = 4;
+  b.seen = true;
+  b.buckets = { { 10, 20, 30 } };
+  b.per_bucket = { 1.0 };
+  b.samples = { 9 };
+  b.entries.emplace_back( new entry_t( "only_b", 100.0 ) );
+  b.entries.emplace_back( new entry_t( "shared", 2.0 ) );
+
+  serialize::writer_t w;
+  a.serialize( w );
+
+  serialize::reader_t r( w.data() );
+  b.serialize( r );
+
+  check( r.empty(), "merge consumes all data" );
+  check( b.count == 5 && b.sum == 2.0, "values are summed" );
+  check( b.min == 1 && b.max == 10, "min/max are combined" );
+  check( b.seen, "any is combined" );
+  check( b.buckets[ 0 ] == 11 && b.buckets[ 1 ] == 22 && b.buckets[ 2 ] == 33, "arrays are merged element-wise" );
+  check( b.per_bucket.size() == 3 && b.per_bucket[ 0 ] == 2.0 && b.per_bucket[ 2 ] == 3.0,
+         "vectors are merged element-wise and grown" );
+  check( b.samples.size() == 3 && b.samples[ 0 ] == 9 && b.samples[ 1 ] == 7 && b.samples[ 2 ] == 8,
+         "append concatenates" );
+  check( b.find( "shared" ) -> value == 3.0, "named entries are merged by key" );
+  check( b.find( "only_b" ) -> value == 100.0 && ! b.find( "only_a" ), "unknown named entries are skipped" );
+  check( r.skipped() == std::vector<std::string>{ "only_a" }, "skipped entries are recorded" );
+}
+
+void test_skipped()
+{
+  std::vector<std::unique_ptr<group_t>> a, b;
+  a.emplace_back( new group_t( "group" ) );
+  a.back() -> state.entries.emplace_back( new entry_t( "shared", 1.0 ) );
+  a.back() -> state.entries.emplace_back( new entry_t( "inner", 2.0 ) );
+  a.emplace_back( new group_t( "outer" ) );
+  b.emplace_back( new group_t( "group" ) );
+  b.back() -> state.entries.emplace_back( new entry_t( "shared", 1.0 ) );
+
+  serialize::writer_t w;
+  serialize_groups( w, a );
+
+  serialize::reader_t r( w.data() );
+  serialize_groups( r, b );
+
+  check( r.empty(), "nested merge consumes all data" );
+  check( b[ 0 ] -> state.find( "shared" ) -> value == 2.0, "nested entries are merged by key" );
+  check( r.skipped() == std::vector<std::string>( { "group/inner", "outer" } ),
+         "skipped keys of nested collections include the enclosing key" );
+
+  serialize::reader_t all( w.data() );
+  serialize_groups( all, a );
+  check( all.skipped().empty(), "nothing is skipped when every key has a counterpart" );
+}
+
+void test_version_mismatch()
+{
+  std::string data = write_version( 1 );
+
+  serialize::reader_t same( data );
+  check( ! throws( [ &same ]() { same.match( uint32_t( 1 ) ); } ), "matching version is accepted" );
+  check( same.read_string() == "payload", "data after version is readable" );
+
+  serialize::reader_t other( data );
+  check( throws( [ &other ]() { other.match( uint32_t( 2 ) ); } ), "version mismatch throws" );
+
+  std::array<int, 2> a = { { 0, 0 } };
+  serialize::writer_t w;
+  std::array<int, 3> b = { { 1, 2, 3 } };
+  w( b );
+  serialize::reader_t r( w.data() );
+  check( throws( [ &r, &a ]() { r( a ); } ), "array length mismatch throws" );
+}
+
+void test_truncated()
+{
+  state_t a;
+  a.count = 1;
+  a.per_bucket = { 1.0, 2.0 };
+  a.samples = { 1, 2, 3 };
+  a.entries.emplace_back( new entry_t( "entry", 1.0 ) );
+
+  serialize::writer_t w;
+  a.serialize( w );
+  const std::string& data = w.data();
+
+  bool all_throw = true;
+  for ( size_t n = 0; n < data.size(); ++n )
+  {
+    state_t b;
+    b.entries.emplace_back( new entry_t( "entry", 0.0 ) );
+    serialize::reader_t r( data.data(), data.data() + n );
+    if ( ! throws( [ &r, &b ]() { b.serialize( r ); } ) )
+    {
+      all_throw = false;
+      std::cout << "  no error when truncated to " << n << " of " << data.size() << " bytes\n";
+    }
+  }
+  check( all_throw, "every truncation of a state throws" );
+
+  std::string s = write_version( 1 );
+  serialize::reader_t r( s.data(), s.data() + s.size() - 1 );
+  r.read<uint32_t>();
+  check( throws( [ &r ]() { r.read_string(); } ), "truncated string throws" );
+}
+
+} // UNNAMED NAMESPACE
+
+int main( int /*argc*/, char** /*argv*/ )
+{
+  test_values();
+  test_merge();
+  test_skipped();
+  test_version_mismatch();
+  test_truncated();
+
+  return unit_test::result();
+}
+#endif // UNIT_TEST
@@ -0,0 +1,276 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#ifndef SERIALIZE_HPP
+#define SERIALIZE_HPP
+
+#include "config.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/* Compact binary archives for mergeable simulation state.
+ *
+ * Data collection types implement a single
+ *
+ *   template <typename Archive> void serialize( Archive& ar );
+ *
+ * which, given a writer_t, appends the object state to a byte buffer, and
+ * given a reader_t, merges previously written state into the object with the
+ * same semantics as the object's merge(). Archived values therefore have to
+ * be mergeable: ar( x ) sums, ar.min()/ar.max()/ar.any() combine, ar.append()
+ * concatenates, and ar.match() requires both sides to be equal.
+ *
+ * Named collections (stats, buffs, procs, ...) are written as key and a
+ * length-prefixed block, so entries without a counterpart on the reading side
+ * are skipped instead of corrupting the rest of the stream. The reader records
+ * the keys of skipped entries, callers decide whether losing them is an error.
+ *
+ * The format uses native byte order and type sizes.
+ */
+namespace serialize
+{
+class writer_t
+{
+  std::string _data;
+
+public:
+  const std::string& data() const
+  { return _data; }
+
+  template <typename T>
+  void write( const T& v )
+  {
+    static_assert( std::is_arithmetic<T>::value, "Only arithmetic values can be written" );
+    _data.append( reinterpret_cast<const char*>( &v ), sizeof( v ) );
+  }
+
+  void write_string( const std::string& s )
+  {
+    write( static_cast<uint64_t>( s.size() ) );
+    _data.append( s );
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value>::type operator()( T& v )
+  { write( v ); }
+
+  template <typename T>
+  typename std::enable_if<std::is_class<T>::value>::type operator()( T& v )
+  { v.serialize( *this ); }
+
+  template <typename T, size_t N>
+  void operator()( std::array<T, N>& a )
+  {
+    write( static_cast<uint64_t>( N ) );
+    for ( auto& v : a )
+      ( *this )( v );
+  }
+
+  template <typename T>
+  void operator()( std::vector<T>& a )
+  {
+    write( static_cast<uint64_t>( a.size() ) );
+    for ( auto& v : a )
+      ( *this )( v );
+  }
+
+  template <typename T>
+  void min( T& v )
+  { write( v ); }
+
+  template <typename T>
+  void max( T& v )
+  { write( v ); }
+
+  void any( bool& v )
+  { write( v ); }
+
+  template <typename T>
+  void append( std::vector<T>& a )
+  {
+    write( static_cast<uint64_t>( a.size() ) );
+    _data.append( reinterpret_cast<const char*>( a.data() ), a.size() * sizeof( T ) );
+  }
+
+  template <typename T>
+  void match( const T& v )
+  { write( v ); }
+
+  // Write a named collection. Fn is called as fn( archive, element ).
+  template <typename Range, typename Key, typename Find, typename Fn>
+  void named( const Range& r, Key key, Find, Fn fn )
+  {
+    write( static_cast<uint64_t>( r.size() ) );
+    for ( auto& e : r )
+    {
+      write_string( key( *e ) );
+
+      size_t offset = _data.size();
+      write( uint64_t() );
+      fn( *this, *e );
+      uint64_t length = _data.size() - offset - sizeof( uint64_t );
+      std::memcpy( &_data[ offset ], &length, sizeof( length ) );
+    }
+  }
+};
+
+class reader_t
+{
+  const char* _pos;
+  const char* _end;
+  // Keys of skipped named entries, shared with the readers of nested blocks
+  std::vector<std::string> _skipped_keys;
+  std::vector<std::string>* _skipped;
+  std::string _scope;
+
+  reader_t( const char* begin, const char* end, reader_t& parent, const std::string& key ) :
+    _pos( begin ), _end( end ), _skipped( parent._skipped ), _scope( parent._scope + key + "/" )
+  { }
+
+  void need( size_t n ) const
+  {
+    if ( static_cast<size_t>( _end - _pos ) < n )
+      throw std::runtime_error( "Truncated serialized data" );
+  }
+
+public:
+  reader_t( const char* begin, const char* end ) :
+    _pos( begin ), _end( end ), _skipped( &_skipped_keys )
+  { }
+
+  explicit reader_t( const std::string& data ) :
+    _pos( data.data() ), _end( data.data() + data.size() ), _skipped( &_skipped_keys )
+  { }
+
+  reader_t( const reader_t& ) = delete;
+  reader_t& operator=( const reader_t& ) = delete;
+
+  // Keys ( "outer/inner" for nested collections ) of the named entries that
+  // had no counterpart on this side
+  const std::vector<std::string>& skipped() const
+  { return *_skipped; }
+
+  bool empty() const
+  { return _pos == _end; }
+
+  template <typename T>
+  T read()
+  {
+    static_assert( std::is_arithmetic<T>::value, "Only arithmetic values can be read" );
+    T v;
+    need( sizeof( v ) );
+    std::memcpy( &v, _pos, sizeof( v ) );
+    _pos += sizeof( v );
+    return v;
+  }
+
+  std::string read_string()
+  {
+    size_t n = static_cast<size_t>( read<uint64_t>() );
+    need( n );
+    std::string s( _pos, n );
+    _pos += n;
+    return s;
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value>::type operator()( T& v )
+  { v += read<T>(); }
+
+  template <typename T>
+  typename std::enable_if<std::is_class<T>::value>::type operator()( T& v )
+  { v.serialize( *this ); }
+
+  template <typename T, size_t N>
+  void operator()( std::array<T, N>& a )
+  {
+    if ( read<uint64_t>() != N )
+      throw std::runtime_error( "Serialized array length mismatch" );
+    for ( auto& v : a )
+      ( *this )( v );
+  }
+
+  // Vectors are merged element-wise, growing the target when needed
+  template <typename T>
+  void operator()( std::vector<T>& a )
+  {
+    size_t n = static_cast<size_t>( read<uint64_t>() );
+    if ( a.size() < n )
+      a.resize( n );
+    for ( size_t i = 0; i < n; ++i )
+      ( *this )( a[ i ] );
+  }
+
+  template <typename T>
+  void min( T& v )
+  {
+    T other = read<T>();
+    if ( other < v )
+      v = other;
+  }
+
+  template <typename T>
+  void max( T& v )
+  {
+    T other = read<T>();
+    if ( other > v )
+      v = other;
+  }
+
+  void any( bool& v )
+  { v = read<bool>() || v; }
+
+  template <typename T>
+  void append( std::vector<T>& a )
+  {
+    size_t n = static_cast<size_t>( read<uint64_t>() );
+    need( n * sizeof( T ) );
+    size_t offset = a.size();
+    a.resize( offset + n );
+    std::memcpy( a.data() + offset, _pos, n * sizeof( T ) );
+    _pos += n * sizeof( T );
+  }
+
+  template <typename T>
+  void match( const T& v )
+  {
+    if ( read<T>() != v )
+      throw std::runtime_error( "Serialized data does not match the current configuration" );
+  }
+
+  // Merge a named collection. Find maps a key to an element pointer, or
+  // nullptr if the element does not exist on this side.
+  template <typename Range, typename Key, typename Find, typename Fn>
+  void named( const Range&, Key, Find find, Fn fn )
+  {
+    size_t n = static_cast<size_t>( read<uint64_t>() );
+    for ( size_t i = 0; i < n; ++i )
+    {
+      std::string key = read_string();
+      size_t length = static_cast<size_t>( read<uint64_t>() );
+      need( length );
+
+      if ( auto e = find( key ) )
+      {
+        reader_t block( _pos, _pos + length, *this, key );
+        fn( block, *e );
+      }
+      else
+      {
+        _skipped -> push_back( _scope + key );
+      }
+      _pos += length;
+    }
+  }
+};
+}  // serialize
+
+#endif  // SERIALIZE_HPP
@@ -20,6 +20,7 @@
 
 #if !defined(SC_WINDOWS)
 #include <sys/time.h>
+#include <sys/resource.h>
 #endif
 
 // If you turn this on, you will need to add -lrt to LINK_LIBS in Makefile
@@ -152,6 +153,18 @@ stopwatch_t::time_point_t stopwatch_t::now() const
     return out;
   }
 #else
+#if defined(RUSAGE_THREAD)
+  if ( type == STOPWATCH_THREAD )
+  {
+    struct rusage ru;
+    getrusage( RUSAGE_THREAD, &ru );
+    stopwatch_t::time_point_t out;
+    out.sec = ru.ru_utime.tv_sec;
+    out.usec = ru.ru_utime.tv_usec;
+    return out;
+  }
+#endif
+  // Without per-thread CPU time, thread stopwatches measure wall time
   if ( type == STOPWATCH_WALL ||
       type == STOPWATCH_THREAD )
   {
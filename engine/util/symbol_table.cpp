@@ -0,0 +1,101 @@
+#ifdef UNIT_TEST
+// Tests of the symbol_table_t / symbol_index_t registry lookups
+
+#include "symbol_table.hpp"
+#include "unit_test.hpp"
+#include <iostream>
+
+namespace
+{
+using unit_test::check;
+
+struct object_t
+{
+  std::string name_str;
+  int source;
+
+  object_t( const std::string& n, int s ) : name_str( n ), source( s )
+  { }
+};
+
+bool any( const object_t* )
+{ return true; }
+
+void test_symbols()
+{
+  symbol_table_t symbols;
+
+  check( symbols.find( "foo" ) == symbol_table_t::npos, "unknown name is npos" );
+
+  unsigned foo = symbols.intern( "foo" );
+  unsigned bar = symbols.intern( "bar" );
+  check( foo == 0 && bar == 1, "symbols are assigned in interning order" );
+  check( symbols.intern( "foo" ) == foo, "interning an existing name returns its symbol" );
+  check( symbols.find( "bar" ) == bar, "find returns the interned symbol" );
+  check( symbols.size() == 2, "size counts unique names" );
+}
+
+void test_index()
+{
+  symbol_table_t symbols;
+  symbol_index_t<object_t> index;
+  std::vector<object_t*> list;
+
+  object_t a( "debuff", 1 ), b( "debuff", 2 ), c( "buff", 1 );
+  for ( auto o : { &a, &b, &c } )
+  {
+    list.push_back( o );
+    index.add( symbols.intern( o -> name_str ), o );
+  }
+
+  check( index.size() == 3, "size counts indexed objects" );
+  check( index.find( symbols.find( "debuff" ) ) == &a, "find returns the first registered object" );
+  check( index.find( symbols.find( "buff" ) ) == &c, "find by symbol" );
+  check( index.find( symbols.intern( "unused" ) ) == nullptr, "symbol without objects finds nothing" );
+  check( index.find( symbol_table_t::npos ) == nullptr, "npos finds nothing" );
+  check( index.find( symbols.find( "debuff" ), []( const object_t* o ) { return o -> source == 2; } ) == &b,
+         "predicate find walks objects in registration order" );
+  check( index.find( symbols.find( "debuff" ), []( const object_t* o ) { return o -> source == 3; } ) == nullptr,
+         "predicate find without a match finds nothing" );
+
+  bool linear = true;
+  check( index.find( symbols, list, "debuff", any, &linear ) == &a && ! linear,
+         "registry find uses the index when it covers the list" );
+  check( index.find( symbols, list, "missing", any, &linear ) == nullptr && ! linear,
+         "registry find of an unknown name" );
+}
+
+void test_fallback()
+{
+  symbol_table_t symbols;
+  symbol_index_t<object_t> index;
+  std::vector<object_t*> list;
+
+  object_t a( "indexed", 1 ), b( "unindexed", 1 ), c( "unindexed", 2 );
+  list.push_back( &a );
+  index.add( symbols.intern( a.name_str ), &a );
+
+  // Added to the registry list directly, bypassing the index
+  list.push_back( &b );
+  list.push_back( &c );
+
+  bool linear = false;
+  check( index.find( symbols, list, "unindexed", any, &linear ) == &b && linear,
+         "registry find falls back to a linear search when the index is incomplete" );
+  check( index.find( symbols, list, "unindexed", []( const object_t* o ) { return o -> source == 2; } ) == &c,
+         "linear search applies the predicate" );
+  check( index.find( symbols, list, "indexed", any ) == &a, "linear search finds indexed objects" );
+  check( index.find( symbols, list, "missing", any ) == nullptr, "linear search of an unknown name" );
+}
+
+} // UNNAMED NAMESPACE
+
+int main( int /*argc*/, char** /*argv*/ )
+{
+  test_symbols();
+  test_index();
+  test_fallback();
+
+  return unit_test::result();
+}
+#endif // UNIT_TEST
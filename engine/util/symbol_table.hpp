@@ -0,0 +1,119 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#ifndef SYMBOL_TABLE_HPP
+#define SYMBOL_TABLE_HPP
+
+#include "config.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* Interned names for per-actor object registries.
+ *
+ * An actor registers buffs, cooldowns, stats, gains, procs, dots, ... by
+ * name, and the same names are looked up over and over again while actions,
+ * buffs and expressions are created. The symbol table maps every name to a
+ * small integer once, and each registry keeps a symbol_index_t over its
+ * objects. A lookup hashes the name once and is then a vector access,
+ * independent of the number of registered objects.
+ */
+class symbol_table_t
+{
+  std::unordered_map<std::string, unsigned> symbols;
+
+public:
+  static const unsigned npos = ~0u;
+
+  // Symbol of the name, npos if the name has never been interned
+  unsigned find( const std::string& name ) const
+  {
+    auto it = symbols.find( name );
+    return it != symbols.end() ? it -> second : npos;
+  }
+
+  unsigned intern( const std::string& name )
+  {
+    return symbols.insert( std::make_pair( name, static_cast<unsigned>( symbols.size() ) ) ).first -> second;
+  }
+
+  size_t size() const
+  { return symbols.size(); }
+};
+
+// Objects of one registry by symbol, in registration order for objects that
+// share a name (e.g. debuffs from different sources).
+template <typename T>
+class symbol_index_t
+{
+  std::vector<std::vector<T*>> index;
+  size_t count;
+
+public:
+  symbol_index_t() : count( 0 )
+  { }
+
+  void add( unsigned symbol, T* object )
+  {
+    if ( symbol >= index.size() )
+      index.resize( symbol + 1 );
+    index[ symbol ].push_back( object );
+    ++count;
+  }
+
+  // Number of indexed objects
+  size_t size() const
+  { return count; }
+
+  T* find( unsigned symbol ) const
+  {
+    if ( symbol >= index.size() || index[ symbol ].empty() )
+      return nullptr;
+
+    return index[ symbol ].front();
+  }
+
+  // First object of the symbol accepted by the predicate
+  template <typename Predicate>
+  T* find( unsigned symbol, Predicate pred ) const
+  {
+    if ( symbol >= index.size() )
+      return nullptr;
+
+    for ( auto object : index[ symbol ] )
+    {
+      if ( pred( object ) )
+        return object;
+    }
+
+    return nullptr;
+  }
+
+  // First object named name in the registry list accepted by the predicate. Objects added to the
+  // list without going through the index make the index incomplete, in which case the list is
+  // searched linearly and linear (if given) is set.
+  template <typename Predicate>
+  T* find( const symbol_table_t& symbols, const std::vector<T*>& list, const std::string& name,
+           Predicate pred, bool* linear = nullptr ) const
+  {
+    if ( linear )
+      *linear = count != list.size();
+
+    if ( count != list.size() )
+    {
+      for ( auto object : list )
+      {
+        if ( object -> name_str == name && pred( object ) )
+          return object;
+      }
+      return nullptr;
+    }
+
+    return find( symbols.find( name ), pred );
+  }
+};
+
+#endif  // SYMBOL_TABLE_HPP
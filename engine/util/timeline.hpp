@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <cassert>
 #include <numeric>
+#include <cmath>
 
 #include "generic.hpp"
 #include "sample_data.hpp"
@@ -146,6 +147,14 @@ public:
       _data.insert( _data.end(), other.data().begin() + _data.size(), other.data().end() );
   }
 
+  template <typename Archive>
+  void serialize( Archive& ar )
+  { ar( _data ); }
+
+  // Turn a timeline of value changes into a timeline of values (running sum)
+  void accumulate()
+  { std::partial_sum( _data.begin(), _data.end(), _data.begin() ); }
+
   void build_sliding_average_timeline( timeline_t& out, unsigned window ) const
   {
     out._data.reserve( data().size() );
@@ -388,6 +397,19 @@ struct sc_timeline_t : public timeline_t
     }
   }
 
+  // Sparse collection: the timeline holds value changes, and is turned into values by
+  // accumulate(). A change of 'delta' at 'current_time' is visible from the first bin at or
+  // after it.
+  void add_delta( timespan_t current_time, double delta )
+  {
+    double bin_millis = 1000 * bin_size;
+    base_t::add( static_cast<size_t>( std::ceil( current_time.total_millis() / bin_millis ) ), delta );
+  }
+
+  // Sparse collection: remove 'value' from all bins after the one containing 'current_time'
+  void end_delta( timespan_t current_time, double value )
+  { base_t::add( static_cast<size_t>( current_time.total_millis() / 1000 / bin_size ) + 1, -value ); }
+
   void adjust( sim_t& sim );
   void adjust( const extended_sample_data_t& adjustor );
 
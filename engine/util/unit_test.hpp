@@ -0,0 +1,36 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#ifndef UNIT_TEST_HPP
+#define UNIT_TEST_HPP
+
+#include <iostream>
+
+/* Checks for the UNIT_TEST mains of the util/ components. Every check prints
+ * its outcome, and result() gives the exit status of the test.
+ */
+namespace unit_test
+{
+inline int& failures()
+{
+  static int n = 0;
+  return n;
+}
+
+inline void check( bool condition, const char* what )
+{
+  std::cout << ( condition ? "ok     " : "FAILED " ) << what << "\n";
+  if ( ! condition )
+    failures()++;
+}
+
+inline int result()
+{
+  std::cout << ( failures() ? "FAILED" : "PASSED" ) << "\n";
+  return failures() ? 1 : 0;
+}
+}  // unit_test
+
+#endif  // UNIT_TEST_HPP
@@ -4,8 +4,10 @@
 
  HEADERS += engine/util/xml.hpp
  HEADERS += engine/util/timeline.hpp
+ HEADERS += engine/util/symbol_table.hpp
  HEADERS += engine/util/str.hpp
  HEADERS += engine/util/stopwatch.hpp
+ HEADERS += engine/util/serialize.hpp
  HEADERS += engine/util/sc_resourcepaths.hpp
  HEADERS += engine/util/sample_data.hpp
  HEADERS += engine/util/rng.hpp
@@ -36,18 +38,25 @@
  SOURCES += engine/util/rng.cpp
  SOURCES += engine/util/io.cpp
  SOURCES += engine/util/concurrency.cpp
+ SOURCES += engine/sim/sc_thread_affinity.cpp
  SOURCES += engine/sim/sc_sim.cpp
+ SOURCES += engine/sim/sc_shard.cpp
  SOURCES += engine/sim/sc_scaling.cpp
  SOURCES += engine/sim/sc_reforge_plot.cpp
  SOURCES += engine/sim/sc_raid_event.cpp
  SOURCES += engine/sim/sc_progress_bar.cpp
  SOURCES += engine/sim/sc_plot.cpp
+ SOURCES += engine/sim/sc_phase_timing.cpp
  SOURCES += engine/sim/sc_option.cpp
+ SOURCES += engine/sim/sc_memory_report.cpp
+ SOURCES += engine/sim/sc_iteration_export.cpp
  SOURCES += engine/sim/sc_gear_stats.cpp
  SOURCES += engine/sim/sc_expressions.cpp
  SOURCES += engine/sim/sc_event.cpp
  SOURCES += engine/sim/sc_core_sim.cpp
  SOURCES += engine/sim/sc_cooldown.cpp
+ SOURCES += engine/sim/sc_comparison.cpp
+ SOURCES += engine/sim/sc_checkpoint.cpp
  SOURCES += engine/report/sc_report_xml.cpp
  SOURCES += engine/report/sc_report_text.cpp
  SOURCES += engine/report/sc_report_json.cpp
@@ -0,0 +1,183 @@
+#!/usr/bin/python
+# Performance benchmark over the shipped Tier profiles.
+#
+# Runs a fixed matrix of profiles/Tier19M and profiles/Tier19H specs, with a
+# single target and an AoE fight, on 1 and N threads with a fixed seed. Every
+# run writes its throughput and resource numbers through simc's bench_file=
+# option (events/sec, iterations/sec, init, merge and report time, peak RSS).
+# The collected results are written as JSON, and optionally compared against a
+# stored baseline produced by an earlier run of this script.
+#
+# Usage:
+#   benchmark.py [--simc ../engine/simc] [--output bench.json]
+#                [--baseline baseline.json] [--tolerance 0.05]
+#                [--iterations 500] [--threads N] [--repetitions 1]
+#                [--tiers Tier19M,Tier19H] [--specs Mage_Fire,...] [simc options ...]
+#
+# The exit status is 1 if a metric regressed by more than the tolerance
+# compared to the baseline.
+import os
+import sys
+import json
+import shutil
+import argparse
+import tempfile
+import subprocess
+import multiprocessing
+
+SPECS = [
+    "Death_Knight_Frost",
+    "Demon_Hunter_Havoc",
+    "Druid_Balance",
+    "Druid_Feral",
+    "Hunter_BM",
+    "Mage_Fire",
+    "Monk_Windwalker",
+    "Paladin_Retribution",
+    "Priest_Shadow",
+    "Rogue_Assassination",
+    "Shaman_Elemental",
+    "Shaman_Enhancement",
+    "Warlock_Affliction",
+    "Warrior_Fury",
+]
+
+TIERS = ["Tier19M", "Tier19H"]
+
+FIGHT_STYLES = {
+    "single_target": ["fight_style=Patchwerk", "desired_targets=1"],
+    "aoe": ["fight_style=Patchwerk", "desired_targets=5"],
+}
+
+SEED = 1
+
+# Metric name, True if higher values are better
+METRICS = [
+    ("events_per_second", True),
+    ("iterations_per_second", True),
+    ("init_seconds", False),
+    ("merge_seconds", False),
+    ("report_seconds", False),
+    ("peak_rss_bytes", False),
+]
+
+
+def run(simc, profile, style, threads, iterations, workdir, extra_options):
+    bench_file = os.path.join(workdir, "bench.json")
+    command = [simc, profile, "iterations={}".format(iterations), "threads={}".format(threads),
+               "seed={}".format(SEED), "target_error=0", "output=" + os.path.join(workdir, "report.txt"),
+               "html=" + os.path.join(workdir, "report.html"), "bench_file=" + bench_file]
+    command += FIGHT_STYLES[style]
+    command += extra_options
+
+    with open(os.devnull, "w") as null:
+        subprocess.check_call(command, stdout=null)
+
+    with open(bench_file) as f:
+        return json.load(f)
+
+
+def best_of(results):
+    """Best value of every metric over the repetitions of a run."""
+    best = dict(results[0])
+    for name, higher_is_better in METRICS:
+        values = [r[name] for r in results]
+        best[name] = max(values) if higher_is_better else min(values)
+    return best
+
+
+def compare(results, baseline, tolerance, min_seconds):
+    regressions = []
+    base = {r["key"]: r for r in baseline["results"]}
+
+    print("{:<52} {:<22} {:>14} {:>14} {:>8}".format("run", "metric", "baseline", "current", "change"))
+    for r in results:
+        b = base.get(r["key"])
+        if b is None:
+            continue
+
+        for name, higher_is_better in METRICS:
+            old, new = b.get(name, 0), r[name]
+            if old <= 0:
+                continue
+            # Sub-threshold phase times are dominated by noise
+            if name.endswith("_seconds") and max(old, new) < min_seconds:
+                continue
+
+            change = new / old - 1.0
+            regressed = change < -tolerance if higher_is_better else change > tolerance
+            if regressed:
+                regressions.append((r["key"], name))
+            print("{:<52} {:<22} {:>14.4g} {:>14.4g} {:>+7.1f}%{}".format(
+                r["key"], name, old, new, 100.0 * change, " REGRESSION" if regressed else ""))
+
+    missing = set(base) - set(r["key"] for r in results)
+    for key in sorted(missing):
+        print("{:<52} not run".format(key))
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark simc over the Tier19M/Tier19H profiles")
+    parser.add_argument("--simc", default="../engine/simc")
+    parser.add_argument("--profiles", default="../profiles")
+    parser.add_argument("--output", default="bench.json", help="write the results to this JSON file")
+    parser.add_argument("--baseline", help="compare the results against this JSON file")
+    parser.add_argument("--tolerance", type=float, default=0.05, help="allowed relative regression")
+    parser.add_argument("--min-seconds", type=float, default=0.05,
+                        help="ignore phase times below this many seconds in the comparison")
+    parser.add_argument("--iterations", type=int, default=500)
+    parser.add_argument("--threads", type=int, default=multiprocessing.cpu_count(),
+                        help="thread count of the multi-threaded runs")
+    parser.add_argument("--repetitions", type=int, default=1, help="repeat every run, keep the best values")
+    parser.add_argument("--tiers", default=",".join(TIERS))
+    parser.add_argument("--specs", default=",".join(SPECS))
+    args, extra_options = parser.parse_known_args()
+
+    thread_counts = sorted(set([1, max(args.threads, 1)]))
+    workdir = tempfile.mkdtemp(prefix="simc_bench")
+    results = []
+    try:
+        for tier in args.tiers.split(","):
+            for spec in args.specs.split(","):
+                profile = os.path.join(args.profiles, tier, "{}_T{}.simc".format(spec, tier[4:]))
+                for style in sorted(FIGHT_STYLES):
+                    for threads in thread_counts:
+                        key = "{}/{}/{}/threads={}".format(tier, spec, style, threads)
+                        runs = [run(args.simc, profile, style, threads, args.iterations, workdir, extra_options)
+                                for _ in range(args.repetitions)]
+                        result = best_of(runs)
+                        result["key"] = key
+                        results.append(result)
+                        print("{:<52} {:>12.0f} events/s {:>8.1f} iterations/s {:>7.3f}s init {:>7.1f} MB".format(
+                            key, result["events_per_second"], result["iterations_per_second"],
+                            result["init_seconds"], result["peak_rss_bytes"] / (1024.0 * 1024.0)))
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+    output = {
+        "config": {
+            "iterations": args.iterations,
+            "threads": thread_counts,
+            "seed": SEED,
+            "repetitions": args.repetitions,
+            "extra_options": extra_options,
+        },
+        "results": results,
+    }
+    with open(args.output, "w") as f:
+        json.dump(output, f, indent=2, sort_keys=True)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        if baseline.get("config", {}).get("iterations") != args.iterations:
+            print("Warning: baseline was recorded with a different iteration count")
+        regressions = compare(results, baseline, args.tolerance, args.min_seconds)
+        if regressions:
+            print("{} metrics regressed by more than {:.0f}%".format(len(regressions), 100 * args.tolerance))
+            sys.exit(1)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,75 @@
+#!/usr/bin/python
+# Startup benchmark: actor initialization time of a raid profile.
+#
+# Runs simc repeatedly with init_timing=1 and reports the mean initialization
+# time per actor, together with the registry sizes (buffs, cooldowns, stats,
+# ...) that drive the cost of name lookups during initialization.
+#
+# Usage:
+#   init_benchmark.py [--simc ../engine/simc] [--profile ../profiles/Tier19M/Raid_T19M.simc]
+#                     [--repetitions 5] [simc options ...]
+import sys
+import argparse
+import subprocess
+
+
+def run(simc, profile, extra_options):
+    command = [simc, profile, "init_timing=1", "iterations=1", "threads=1", "max_time=10",
+               "report_details=0", "output=" + ("NUL" if sys.platform == "win32" else "/dev/null")]
+    command += extra_options
+    output = subprocess.check_output(command, universal_newlines=True)
+
+    actors = []
+    total = None
+    for line in output.splitlines():
+        tokens = line.split()
+        if not tokens or tokens[0] != "init_time":
+            continue
+
+        is_total = tokens[1] == "total"
+        fields = dict(f.split("=", 1) for f in tokens[2 if is_total else 1:])
+        fields["time"] = float(fields["time"].rstrip("ms"))
+        if is_total:
+            total = fields["time"]
+        else:
+            actors.append(fields)
+
+    if total is None:
+        raise RuntimeError("No init_time output, is the simc binary built with init_timing support?")
+
+    return actors, total
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Measure simc actor initialization time")
+    parser.add_argument("--simc", default="../engine/simc")
+    parser.add_argument("--profile", default="../profiles/Tier19M/Raid_T19M.simc")
+    parser.add_argument("--repetitions", type=int, default=5)
+    args, extra_options = parser.parse_known_args()
+
+    times = []
+    totals = []
+    actors = []
+    for repetition in range(args.repetitions):
+        actors, total = run(args.simc, args.profile, extra_options)
+        totals.append(total)
+        # Actors are reported in a fixed order, pets may share names
+        if len(times) != len(actors):
+            times = [[] for _ in actors]
+        for i, a in enumerate(actors):
+            times[i].append(a["time"])
+        print("Run {}/{}: {:.3f}ms".format(repetition + 1, args.repetitions, total))
+
+    width = max([len(a["actor"]) for a in actors] + [5])
+    print("{:<{w}} {:>10} {:>8} {:>6} {:>9} {:>6} {:>6} {:>6} {:>5} {:>8}".format(
+        "actor", "init (ms)", "symbols", "buffs", "cooldowns", "stats", "gains", "procs", "dots", "actions", w=width))
+    for i, a in enumerate(actors):
+        print("{:<{w}} {:>10.3f} {:>8} {:>6} {:>9} {:>6} {:>6} {:>6} {:>5} {:>8}".format(
+            a["actor"], sum(times[i]) / len(times[i]), a["symbols"], a["buffs"], a["cooldowns"], a["stats"],
+            a["gains"], a["procs"], a["dots"], a["actions"], w=width))
+
+    print("actors: {} mean total: {:.3f}ms min total: {:.3f}ms".format(
+        len(actors), sum(totals) / len(totals), min(totals)))
+
+if __name__ == "__main__":
+    main()
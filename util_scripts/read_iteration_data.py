@@ -0,0 +1,128 @@
+#!/usr/bin/python
+# Reader for the columnar per-iteration data written by simc with
+# iteration_data_file=<file>.
+#
+# The file is a sequence of self-describing chunks (one per 4096 iterations
+# and thread), all in native (little endian) byte order:
+#
+#   uint32 magic ("SSIC"), uint32 version, uint32 thread, uint32 rows,
+#   uint32 columns, then per column:
+#     uint64 name length, name, uint8 encoding (0 = f64, 1 = u32), rows values
+#
+# Usage:
+#   read_iteration_data.py <file>                   per column summary
+#   read_iteration_data.py <file> --csv <out.csv>   all rows as CSV
+#   read_iteration_data.py <file> --columns a,b     restrict to columns
+#
+# Columns that are missing from a chunk (e.g. stats created later during the
+# simulation) are reported as empty CSV cells.
+import sys
+import struct
+import argparse
+
+CHUNK_MAGIC = 0x43495353
+CHUNK_VERSION = 1
+ENCODINGS = {0: ("d", 8), 1: ("I", 4)}
+
+
+def read_exact(f, n):
+    data = f.read(n)
+    if len(data) != n:
+        raise IOError("Truncated iteration data file")
+    return data
+
+
+def chunks(path, load_data=True):
+    """Yield (thread, rows, {column: values}) for every chunk in the file."""
+    with open(path, "rb") as f:
+        while True:
+            header = f.read(20)
+            if not header:
+                return
+            if len(header) != 20:
+                raise IOError("Truncated iteration data file")
+
+            magic, version, thread, rows, ncols = struct.unpack("<5I", header)
+            if magic != CHUNK_MAGIC:
+                raise IOError("Not an iteration data file")
+            if version != CHUNK_VERSION:
+                raise IOError("Unsupported iteration data version {}".format(version))
+
+            columns = {}
+            for _ in range(ncols):
+                (name_length,) = struct.unpack("<Q", read_exact(f, 8))
+                name = read_exact(f, name_length).decode("utf-8")
+                (encoding,) = struct.unpack("<B", read_exact(f, 1))
+                fmt, size = ENCODINGS[encoding]
+                if load_data:
+                    columns[name] = struct.unpack("<{}{}".format(rows, fmt), read_exact(f, rows * size))
+                else:
+                    f.seek(rows * size, 1)
+                    columns[name] = None
+
+            yield thread, rows, columns
+
+
+def column_names(path, selected):
+    names = ["thread"]
+    seen = set(names)
+    for _, _, columns in chunks(path, load_data=False):
+        for name in columns:
+            if name not in seen and (not selected or name in selected):
+                seen.add(name)
+                names.append(name)
+    return names
+
+
+def write_csv(path, out_path, selected):
+    names = column_names(path, selected)
+    with open(out_path, "w") as out:
+        out.write(",".join(names) + "\n")
+        for thread, rows, columns in chunks(path):
+            columns["thread"] = [thread] * rows
+            for row in range(rows):
+                out.write(",".join(repr(columns[n][row]) if n in columns else "" for n in names) + "\n")
+
+
+def summarize(path, selected):
+    stats = {}
+    order = []
+    total_rows = 0
+    for _, rows, columns in chunks(path):
+        total_rows += rows
+        for name, values in columns.items():
+            if selected and name not in selected:
+                continue
+            if name not in stats:
+                stats[name] = [0, 0.0, float("inf"), float("-inf")]
+                order.append(name)
+            s = stats[name]
+            s[0] += len(values)
+            s[1] += sum(values)
+            s[2] = min(s[2], min(values))
+            s[3] = max(s[3], max(values))
+
+    print("iterations: {}".format(total_rows))
+    width = max([len(n) for n in order] + [6])
+    print("{:<{w}} {:>10} {:>16} {:>16} {:>16}".format("column", "count", "mean", "min", "max", w=width))
+    for name in order:
+        count, total, lo, hi = stats[name]
+        print("{:<{w}} {:>10} {:>16.4f} {:>16.4f} {:>16.4f}".format(name, count, total / count, lo, hi, w=width))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Read simc per-iteration data exports")
+    parser.add_argument("file")
+    parser.add_argument("--csv", help="write all rows to this CSV file")
+    parser.add_argument("--columns", help="comma separated list of columns to include")
+    args = parser.parse_args()
+
+    selected = set(args.columns.split(",")) if args.columns else None
+
+    if args.csv:
+        write_csv(args.file, args.csv, selected)
+    else:
+        summarize(args.file, selected)
+
+if __name__ == "__main__":
+    main()
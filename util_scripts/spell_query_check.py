@@ -0,0 +1,135 @@
+#!/usr/bin/python
+# Regression check for spell_query results.
+#
+# Runs a fixed set of spell_query strings, covering the set operators (&, |, -),
+# the indexed integer field and class/race/school/attribute filters, and effect
+# fields, and compares the XML output of every query against a baseline. The
+# baseline is either the output of another simc binary (e.g. one built before a
+# change to the spell query code), or a file saved by an earlier run of this
+# script with --save.
+#
+# Usage:
+#   spell_query_check.py [--simc ../engine/simc]
+#                        [--baseline-simc old_simc | --baseline queries.json]
+#                        [--save queries.json] [--ptr]
+#
+# The exit status is 1 if the output of any query differs from the baseline.
+import os
+import sys
+import json
+import argparse
+import tempfile
+import subprocess
+
+QUERIES = [
+    # Indexed integer fields
+    "spell.id=133",
+    "spell.family=3",
+    "spell.max_stack=5",
+    "spell.gcd=0&spell.class=mage",
+    "spell.name=fireball",
+    # Class, race, school and attribute masks
+    "spell.class=mage",
+    "spell.class!=mage&spell.school=arcane",
+    "spell.school=fire",
+    "spell.school=frostfire",
+    "spell.school!=physical&spell.class=warrior",
+    "race_spell.race=orc",
+    "race_spell.race!=orc",
+    "spell.race!=human&spell.family=0&spell.school=shadow",
+    "spell.attribute=41",
+    "spell.attribute=41&spell.class=rogue",
+    # Set operators
+    "spell.class=mage&spell.school=fire",
+    "spell.class=mage|spell.class=warlock",
+    "spell.class=mage-spell.school=fire",
+    "class_spell.class=druid|talent_spell.class=druid",
+    "spell.class=priest&spell.school=shadow|spell.class=warlock&spell.school=shadow",
+    "spell.school=fire-spell.class=mage-spell.class=warlock",
+    # Non-indexed fields
+    "spell.max_range>40&spell.class=hunter",
+    "spell.desc~damage&spell.class=monk",
+    "spell.duration<0&spell.class=paladin",
+    # Effects
+    "effect.type=6",
+    "effect.sub_type=4",
+    "effect.type=2&effect.base_value>1000",
+    "effect.trigger_spell=0-effect.type=6",
+    "effect.spell_id=133",
+]
+
+# Queries whose output deliberately changed between revisions, compared
+# against an older simc binary these differences are reported but accepted.
+EXPECTED_CHANGES = {
+    "race_spell.race!=orc": "race!= compared against the class mask before the spell query index",
+    "spell.race!=human&spell.family=0&spell.school=shadow": "race!= compared against the class mask before the spell query index",
+}
+
+
+def run_queries(simc, ptr):
+    results = {}
+    workdir = tempfile.mkdtemp()
+    try:
+        output = os.path.join(workdir, "query.xml")
+        for query in QUERIES:
+            command = [simc, "spell_query=" + query, "spell_query_xml_output_file=" + output]
+            if ptr:
+                command.append("ptr=1")
+
+            with open(os.devnull, "w") as null:
+                subprocess.check_call(command, stdout=null)
+
+            with open(output) as f:
+                results[query] = f.read()
+            os.remove(output)
+    finally:
+        os.rmdir(workdir)
+
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare spell_query results against a baseline")
+    parser.add_argument("--simc", default=os.path.join("..", "engine", "simc"))
+    group = parser.add_mutually_exclusive_group()
+    group.add_argument("--baseline-simc", help="simc binary to produce the baseline results")
+    group.add_argument("--baseline", help="results saved by an earlier --save")
+    parser.add_argument("--save", help="write the results of --simc to this file")
+    parser.add_argument("--ptr", action="store_true", help="query the PTR data")
+    args = parser.parse_args()
+
+    results = run_queries(args.simc, args.ptr)
+
+    if args.save:
+        with open(args.save, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+
+    if args.baseline_simc:
+        baseline = run_queries(args.baseline_simc, args.ptr)
+    elif args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+    else:
+        return 0
+
+    failed = 0
+    for query in QUERIES:
+        if query not in baseline:
+            print("missing  {}".format(query))
+            continue
+
+        if results[query] == baseline[query]:
+            print("ok       {}".format(query))
+        elif args.baseline_simc and query in EXPECTED_CHANGES:
+            print("changed  {} ({})".format(query, EXPECTED_CHANGES[query]))
+        else:
+            print("FAILED   {}".format(query))
+            failed += 1
+
+    print("{} of {} queries differ from the baseline".format(failed, len(QUERIES)))
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())